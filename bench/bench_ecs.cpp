@@ -0,0 +1,184 @@
+#include <vector>
+
+#include "benchmark.hpp"
+#include "utils.hpp"
+
+namespace bench {
+
+using namespace ecs;
+
+void RegisterEcsBenchmarks(Registry& registry)
+{
+    // Création puis destruction de N entités nues.
+    registry.AddSizes("ecs/CreateDestroy", WORLD_SIZES, [](State& state, std::size_t count) {
+        InitECS();
+        std::vector<Entity> entities(count);
+        state.SetItems(count);
+        state.Measure([&] {
+            for (auto& entity : entities) {
+                entity = gCoordinator.CreateEntity();
+            }
+            for (Entity entity : entities) {
+                gCoordinator.DestroyEntity(entity);
+            }
+        });
+    });
+
+    // Entités de projectile complètes : création, 6 composants, destruction.
+    registry.AddSizes("ecs/ProjectileChurn", WORLD_SIZES, [](State& state, std::size_t count) {
+        InitECS();
+        std::vector<Entity> entities(count);
+        state.SetItems(count);
+        state.Measure([&] {
+            for (auto& entity : entities) {
+                entity = gCoordinator.CreateEntity();
+                gCoordinator.AddComponent(entity, Transform{});
+                gCoordinator.AddComponent(entity, Velocity{400.f, 0.f});
+                gCoordinator.AddComponent(entity, Collider{});
+                gCoordinator.AddComponent(entity, Damager{});
+                gCoordinator.AddComponent(entity, Team{});
+                gCoordinator.AddComponent(entity, Lifetime{});
+            }
+            for (Entity entity : entities) {
+                gCoordinator.DestroyEntity(entity);
+            }
+        });
+    });
+
+    // Mort simultanée de N projectiles dans un monde de 1000 ennemis
+    // (destructions demandées deux fois, comme Lifetime + Boundary).
+    registry.AddSizes("ecs/BulletDeaths", {2000}, [](State& state, std::size_t count) {
+        InitECS();
+        for (std::size_t i = 0; i < 1000; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Transform{});
+            gCoordinator.AddComponent(entity, Velocity{});
+            gCoordinator.AddComponent(entity, Collider{});
+            gCoordinator.AddComponent(entity, Health{});
+            gCoordinator.AddComponent(entity, Team{1});
+            gCoordinator.AddComponent(entity, Damager{});
+            gCoordinator.AddComponent(entity, AIController{});
+        }
+        std::vector<Entity> bullets(count);
+        state.SetItems(count);
+        state.MeasureEach(
+            [&] {
+                for (auto& bullet : bullets) {
+                    bullet = gCoordinator.CreateEntity();
+                    gCoordinator.AddComponent(bullet, Transform{});
+                    gCoordinator.AddComponent(bullet, Velocity{400.f, 0.f});
+                    gCoordinator.AddComponent(bullet, Collider{});
+                    gCoordinator.AddComponent(bullet, Damager{});
+                    gCoordinator.AddComponent(bullet, Team{});
+                    gCoordinator.AddComponent(bullet, Lifetime{});
+                    gCoordinator.AddComponent(bullet, Boundary{});
+                }
+                for (Entity bullet : bullets) {
+                    gCoordinator.RequestDestroyEntity(bullet);
+                }
+                for (std::size_t i = 0; i < bullets.size(); i += 4) {
+                    gCoordinator.RequestDestroyEntity(bullets[i]);
+                }
+            },
+            [&] { gCoordinator.ProcessDestructions(); });
+    });
+
+    // Réaction à la mort de 1 % des N entités par tick : parcours de tous
+    // les Health (Poll) ou observateur OnRemove<Health> appelé par lot.
+    for (bool observe : {false, true}) {
+        registry.AddSizes(observe ? "ecs/ReactToDeaths/Observe" : "ecs/ReactToDeaths/Poll", WORLD_SIZES,
+            [observe](State& state, std::size_t count) {
+                InitECS();
+                std::vector<Entity> entities(count);
+                for (auto& entity : entities) {
+                    entity = gCoordinator.CreateEntity();
+                    gCoordinator.AddComponent(entity, Health{});
+                }
+                std::size_t deaths = 0;
+                if (observe) {
+                    gCoordinator.OnRemove<Health>([&deaths](const std::vector<Entity>& removed) {
+                        deaths += removed.size();
+                    });
+                }
+                std::size_t step = 100;
+                std::size_t next = 0;
+                state.SetItems(count);
+                state.Measure([&] {
+                    for (std::size_t i = next % step; i < count; i += step) {
+                        gCoordinator.WriteComponent<Health>(entities[i]).current = 0;
+                        gCoordinator.RequestDestroyEntity(entities[i]);
+                    }
+                    if (!observe) {
+                        for (Entity entity : entities) {
+                            if (gCoordinator.GetComponent<Health>(entity).current <= 0) {
+                                ++deaths;
+                            }
+                        }
+                    }
+                    gCoordinator.ProcessDestructions();
+                    for (std::size_t i = next % step; i < count; i += step) {
+                        entities[i] = gCoordinator.CreateEntity();
+                        gCoordinator.AddComponent(entities[i], Health{});
+                    }
+                    ++next;
+                });
+                DoNotOptimize(deaths);
+            });
+    }
+
+    // Ajout/retrait d'un composant sur N entités existantes.
+    registry.AddSizes("ecs/AddRemoveComponent", WORLD_SIZES, [](State& state, std::size_t count) {
+        InitECS();
+        std::vector<Entity> entities(count);
+        for (auto& entity : entities) {
+            entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Transform{});
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            for (Entity entity : entities) {
+                gCoordinator.AddComponent(entity, Velocity{});
+            }
+            for (Entity entity : entities) {
+                gCoordinator.RemoveComponent<Velocity>(entity);
+            }
+        });
+    });
+
+    // Mise en pause sans changement structurel, à comparer avec
+    // AddRemoveComponent.
+    registry.AddSizes("ecs/DisableEnable", WORLD_SIZES, [](State& state, std::size_t count) {
+        InitECS();
+        std::vector<Entity> entities(count);
+        for (auto& entity : entities) {
+            entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Transform{});
+            gCoordinator.AddComponent(entity, Velocity{});
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.SetEntitiesEnabled(entities, false);
+            gCoordinator.SetEntitiesEnabled(entities, true);
+        });
+    });
+
+    // Lecture d'un composant par entité.
+    registry.AddSizes("ecs/GetComponent", WORLD_SIZES, [](State& state, std::size_t count) {
+        InitECS();
+        std::vector<Entity> entities(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            entities[i] = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entities[i], Transform{static_cast<float>(i), 0.f, 0.f});
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            float sum = 0.f;
+            for (Entity entity : entities) {
+                sum += gCoordinator.GetComponent<Transform>(entity).x;
+            }
+            DoNotOptimize(sum);
+        });
+    });
+}
+
+} // namespace bench
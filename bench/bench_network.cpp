@@ -0,0 +1,159 @@
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "interest.hpp"
+#include "threadQueue.hpp"
+#include "udpClient.hpp"
+#include "utils.hpp"
+
+namespace bench {
+
+namespace {
+
+enum class Replication { Full, Delta, DeltaInterest };
+
+// Réplication vers un client d'une scène de 500 entités en mouvement
+// (450 projectiles, 50 ennemis avec Health) sur 1600x1200, à 60 Hz, le
+// client acquittant avec 3 ticks de retard. Mesure le coût d'encodage par
+// tick ; le compteur bytes_per_tick donne le volume envoyé au client.
+void SnapshotReplication(State& state, Replication mode)
+{
+    using namespace ecs;
+    constexpr float TICK_DT = 1.f / 60.f;
+    constexpr std::uint32_t ACK_DELAY = 3;
+
+    SystemRefs systems = InitECS();
+    for (std::size_t i = 0; i < 500; ++i) {
+        bool enemy = i % 10 == 0;
+        Entity entity = gCoordinator.CreateEntity();
+        float x = static_cast<float>((i * 73) % 1600);
+        float y = static_cast<float>((i * 151) % 1200);
+        gCoordinator.AddComponent(entity, Transform{x, y, 0.f});
+        float speed = enemy ? 60.f : 300.f + static_cast<float>(i % 7) * 20.f;
+        gCoordinator.AddComponent(entity, Velocity{(i % 2) ? speed : -speed, enemy ? speed * 0.5f : 0.f});
+        Boundary boundary{0.f, 1600.f, 0.f, 1200.f, true, false};
+        gCoordinator.AddComponent(entity, boundary);
+        if (enemy) {
+            gCoordinator.AddComponent(entity, Health{});
+        }
+    }
+
+    ClientReplication client;
+    InterestManager interest;
+    ClientView view;
+    std::deque<std::uint32_t> unacked;
+    std::vector<std::uint8_t> packet;
+    std::uint32_t tick = 0;
+    std::size_t bytes = 0;
+    std::size_t ticks = 0;
+
+    auto step = [&] {
+        gCoordinator.AdvanceChangeTick();
+        gCoordinator.AdvanceTick();
+        systems.movementSystem->Update(TICK_DT);
+        systems.boundarySystem->Update();
+        auto world = systems.snapshotSystem->Capture(++tick);
+
+        packet.clear();
+        if (mode == Replication::Full) {
+            WriteSnapshot(*world, nullptr, packet);
+        } else if (mode == Replication::Delta) {
+            client.Encode(world, packet);
+        } else {
+            client.Encode(interest.Filter(*world, client.GetBaseline(tick), view, TICK_DT), packet);
+        }
+        bytes += packet.size();
+        ++ticks;
+
+        unacked.push_back(tick);
+        if (unacked.size() > ACK_DELAY) {
+            client.Acknowledge(unacked.front());
+            unacked.pop_front();
+        }
+    };
+    for (int i = 0; i < 60; ++i) {
+        step();
+    }
+    bytes = 0;
+    ticks = 0;
+    state.SetItems(1);
+    state.Measure(step);
+    state.SetCounter("bytes_per_tick", static_cast<double>(bytes) / static_cast<double>(ticks));
+}
+
+} // namespace
+
+void RegisterNetworkBenchmarks(Registry& registry)
+{
+    // Un seul thread : coût du verrou et de la copie de chaîne.
+    registry.AddSizes("network/ThQueue/PushPop", {1, 64, 1024}, [](State& state, std::size_t count) {
+        ThQueue queue;
+        std::string message(64, 'x');
+        std::string out;
+        state.SetItems(count);
+        state.Measure([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                queue.push(message);
+            }
+            while (queue.try_pop(out)) {
+            }
+        });
+    });
+
+    // Producteur/consommateur sur deux threads, comme réseau -> jeu.
+    registry.AddSizes("network/ThQueue/ProducerConsumer", {10000}, [](State& state, std::size_t count) {
+        ThQueue queue;
+        std::string message(64, 'x');
+        state.SetItems(count);
+        state.Measure([&] {
+            std::thread producer([&] {
+                for (std::size_t i = 0; i < count; ++i) {
+                    queue.push(message);
+                }
+            });
+            std::string out;
+            std::size_t received = 0;
+            while (received < count) {
+                if (queue.try_pop(out)) {
+                    ++received;
+                }
+            }
+            producer.join();
+        });
+    });
+
+    // setSend puis reprise par le thread d'envoi : le paquet reste dans son
+    // buffer du pool d'un bout à l'autre, aucune allocation attendue.
+    registry.AddSizes("network/UdpClient/SendQueue", {1, 32}, [](State& state, std::size_t count) {
+        UdpClient client("127.0.0.1", 4242);
+        std::string payload(64, 'x');
+        BufferPool::Handle packet;
+        state.SetItems(count);
+        state.Measure([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                client.setSend(PacketType::Input, payload);
+            }
+            while (client.getSend()->try_pop(packet)) {
+                DoNotOptimize(packet->size);
+            }
+            packet.reset();
+        });
+    });
+
+    // Octets par tick et par client : snapshot complet, delta sur la
+    // dernière base acquittée, delta filtré par zone visible et budget.
+    registry.Add("network/Snapshot/Full/500", [](State& state) {
+        SnapshotReplication(state, Replication::Full);
+    });
+    registry.Add("network/Snapshot/Delta/500", [](State& state) {
+        SnapshotReplication(state, Replication::Delta);
+    });
+    registry.Add("network/Snapshot/DeltaInterest/500", [](State& state) {
+        SnapshotReplication(state, Replication::DeltaInterest);
+    });
+}
+
+} // namespace bench
@@ -0,0 +1,463 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "utils.hpp"
+
+namespace bench {
+
+using namespace ecs;
+
+namespace {
+
+constexpr float TICK_DT = 1.f / 60.f;
+
+// Position déterministe répartie sur l'écran 800x600.
+Transform Spread(std::size_t i, std::size_t count)
+{
+    std::size_t columns = 1;
+    while (columns * columns < count) {
+        ++columns;
+    }
+    float stepX = 800.f / static_cast<float>(columns);
+    float stepY = 600.f / static_cast<float>(columns);
+    return Transform{(static_cast<float>(i % columns) + 0.5f) * stepX,
+        (static_cast<float>(i / columns) + 0.5f) * stepY, 0.f};
+}
+
+// Vaisseau complet : cible des systèmes IA, collision, santé.
+Entity CreateShip(Transform transform, int team, float radius)
+{
+    Entity entity = gCoordinator.CreateEntity();
+    gCoordinator.AddComponent(entity, transform);
+    gCoordinator.AddComponent(entity, Velocity{});
+    Collider collider;
+    collider.radius = radius;
+    gCoordinator.AddComponent(entity, collider);
+    gCoordinator.AddComponent(entity, Health{});
+    gCoordinator.AddComponent(entity, Team{team});
+    gCoordinator.AddComponent(entity, Damager{});
+    return entity;
+}
+
+// Collision où toutes les paires se touchent ; les colliders sont des
+// triggers pour que la résolution ne détruise rien entre deux itérations.
+void OverlappingCollision(State& state, std::size_t count, bool opposingTeams)
+{
+    SystemRefs systems = InitECS();
+    std::vector<Entity> entities(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        entities[i] = CreateShip(Transform{400.f, 300.f, 0.f}, opposingTeams ? static_cast<int>(i % 2) : 0, 10.f);
+        gCoordinator.WriteComponent<Collider>(entities[i]).isTrigger = true;
+        gCoordinator.WriteComponent<Health>(entities[i]).current = 1 << 30;
+    }
+    state.SetItems(count * (count - 1) / 2);
+    state.Measure([&] {
+        gCoordinator.AdvanceTick();
+        for (Entity entity : entities) {
+            gCoordinator.WriteComponent<Health>(entity).invincibilityTimer = 0.f;
+        }
+        systems.collisionSystem->Update(TICK_DT);
+        systems.damageSystem->Update();
+    });
+}
+
+// Partie en régime stable, côté serveur : 4 joueurs et N ennemis qui
+// tirent (projectiles recyclés), combat au contact, puis capture et
+// encodage du snapshot pour 4 clients qui acquittent chaque tick.
+// Les allocs/it restantes sont les cases de la roue de timers remplies
+// pour la première fois ; après un tour complet (4096 ticks) il n'y en
+// a plus.
+void Match(State& state, std::size_t enemies, const MemoryPolicy& memory)
+{
+    SystemRefs systems = InitECS(memory);
+    for (std::size_t i = 0; i < 4 + enemies; ++i) {
+        bool player = i < 4;
+        Entity entity = CreateShip(Spread(i, 4 + enemies), player ? 0 : 1, 12.f);
+        gCoordinator.WriteComponent<Health>(entity).current = 1 << 30;
+        Boundary boundary;
+        boundary.wrap = true;
+        gCoordinator.AddComponent(entity, boundary);
+        if (player) {
+            gCoordinator.AddComponent(entity, PlayerInput{static_cast<int>(i % 9) + 1, true});
+        } else {
+            gCoordinator.AddComponent(entity, AIController{});
+        }
+        Spawner spawner;
+        spawner.spawnCooldown = (player ? 6.f : 30.f) * TICK_DT;
+        spawner.spawnTimer = static_cast<float>(i % 6) * TICK_DT;
+        spawner.spawnVelocityX = player ? 400.f : -200.f;
+        spawner.spawnVelocityY = 0.f;
+        gCoordinator.AddComponent(entity, spawner);
+    }
+    std::vector<ClientReplication> clients(4);
+    std::vector<std::uint8_t> packet;
+    std::uint32_t tick = 0;
+    auto step = [&] {
+        StepECS(systems, TICK_DT);
+        auto snapshot = systems.snapshotSystem->Capture(++tick);
+        for (auto& client : clients) {
+            packet.clear();
+            client.Encode(snapshot, packet);
+            client.Acknowledge(tick);
+        }
+    };
+    for (int i = 0; i < 400; ++i) {
+        step();
+    }
+    state.SetItems(1);
+    state.Measure(step);
+}
+
+} // namespace
+
+void RegisterSystemBenchmarks(Registry& registry)
+{
+    registry.AddSizes("systems/Movement", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Spread(i, count));
+            gCoordinator.AddComponent(entity, Velocity{1.f, -1.f});
+        }
+        state.SetItems(count);
+        state.Measure([&] { systems.movementSystem->Update(TICK_DT); });
+    });
+
+    registry.AddSizes("systems/Input", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Velocity{});
+            gCoordinator.AddComponent(entity, PlayerInput{static_cast<int>(i % 9) + 1, false});
+        }
+        state.SetItems(count);
+        state.Measure([&] { systems.inputSystem->Update(); });
+    });
+
+    // IA : la moitié des décisions tombe sur chaque tick mesuré (recherche
+    // de cible en O(n) par décision).
+    registry.AddSizes("systems/AI", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = CreateShip(Spread(i, count), static_cast<int>(i % 2), 10.f);
+            AIController ai;
+            ai.decisionCooldown = 2.f * TICK_DT;
+            ai.decisionTimer = (i % 2) ? TICK_DT : 0.f;
+            gCoordinator.AddComponent(entity, ai);
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            gCoordinator.AdvanceTick();
+            systems.aiSystem->Update(TICK_DT);
+        });
+    });
+
+    // Exécution des comportements seule : aucune décision pendant la mesure,
+    // états mélangés (pseudo-aléatoires) et cibles fixées, 3 types d'ennemis.
+    registry.AddSizes("systems/AIBehaviors", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        BehaviorLibrary behaviors;
+        Behavior rusher = DefaultBehavior();
+        rusher.name = "rusher";
+        rusher.actions[static_cast<std::size_t>(AIController::State::Attacking)] = {Motion::Seek, 300.f};
+        Behavior coward = DefaultBehavior();
+        coward.name = "coward";
+        coward.actions[static_cast<std::size_t>(AIController::State::Chasing)] = {Motion::Flee, 80.f};
+        behaviors.Add(rusher);
+        behaviors.Add(coward);
+        systems.aiSystem->SetBehaviors(behaviors);
+
+        std::uint32_t seed = 12345;
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = CreateShip(Spread(i, count), static_cast<int>(i % 2), 10.f);
+            AIController ai = behaviors.MakeController(static_cast<std::uint8_t>(i % 3));
+            ai.decisionCooldown = 1e6f;
+            seed = seed * 1664525u + 1013904223u;
+            ai.currentState = static_cast<AIController::State>((seed >> 16) % AI_STATE_COUNT);
+            ai.target = static_cast<Entity>((i + 1) % count);
+            gCoordinator.AddComponent(entity, ai);
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            gCoordinator.AdvanceTick();
+            systems.aiSystem->Update(TICK_DT);
+        });
+    });
+
+    // Spawner : un tir tous les 10 ticks par spawner, tirs détruits après
+    // chaque tick pour rester en régime stable.
+    registry.AddSizes("systems/Spawner", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        std::size_t spawners = count / 2;
+        for (std::size_t i = 0; i < spawners; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Spread(i, spawners));
+            gCoordinator.AddComponent(entity, Team{0});
+            Spawner spawner;
+            spawner.spawnCooldown = 10.f * TICK_DT;
+            spawner.spawnTimer = static_cast<float>(i % 10) * TICK_DT;
+            gCoordinator.AddComponent(entity, spawner);
+        }
+        state.SetItems(spawners);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            gCoordinator.AdvanceTick();
+            systems.spawnerSystem->Update(TICK_DT);
+            for (Entity entity : systems.lifetimeSystem->entities) {
+                gCoordinator.RequestDestroyEntity(entity);
+            }
+            gCoordinator.ProcessDestructions();
+        });
+    });
+
+    // Même nombre de tirs (1024 tous les 10 ticks, recyclés) : 64 spawners
+    // à salves de 16 en éventail tournant, ou 1024 spawners à tir simple.
+    for (bool pattern : {true, false}) {
+        registry.Add(pattern ? "systems/Volley/Pattern" : "systems/Volley/Spawners", [pattern](State& state) {
+            constexpr int BULLETS = 1024;
+            constexpr int PER_VOLLEY = 16;
+            SystemRefs systems = InitECS();
+            BulletPattern fan;
+            fan.name = "fan";
+            fan.count = PER_VOLLEY;
+            fan.spread = 1.2f;
+            fan.rotationRate = 0.5f;
+            fan.speedStep = 5.f;
+            PatternLibrary patterns;
+            std::uint8_t fanIndex = patterns.Add(fan);
+            systems.spawnerSystem->SetPatterns(patterns);
+
+            int spawners = pattern ? BULLETS / PER_VOLLEY : BULLETS;
+            for (int i = 0; i < spawners; ++i) {
+                Entity entity = gCoordinator.CreateEntity();
+                gCoordinator.AddComponent(entity, Spread(static_cast<std::size_t>(i), static_cast<std::size_t>(spawners)));
+                gCoordinator.AddComponent(entity, Team{0});
+                Spawner spawner;
+                spawner.spawnCooldown = 10.f * TICK_DT;
+                spawner.spawnTimer = static_cast<float>(i % 10) * TICK_DT;
+                spawner.spawnVelocityX = 300.f;
+                spawner.spawnVelocityY = 0.f;
+                if (pattern) {
+                    spawner.pattern = fanIndex;
+                } else {
+                    // Le projectile de rang i % 16 de l'éventail, sans rotation
+                    Velocity velocity = PatternVelocity(fan, spawner, 0, i % PER_VOLLEY);
+                    spawner.spawnVelocityX = velocity.vx;
+                    spawner.spawnVelocityY = velocity.vy;
+                }
+                gCoordinator.AddComponent(entity, spawner);
+            }
+            state.SetItems(BULLETS / 10);
+            state.Measure([&] {
+                gCoordinator.AdvanceChangeTick();
+                gCoordinator.AdvanceTick();
+                systems.spawnerSystem->Update(TICK_DT);
+                for (Entity entity : systems.lifetimeSystem->entities) {
+                    gCoordinator.RequestDestroyEntity(entity);
+                }
+                gCoordinator.ProcessDestructions();
+            });
+        });
+    }
+
+    registry.AddSizes("systems/Health", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            Health health;
+            health.invincibilityTimer = (i % 4 == 0) ? 1e9f : 0.f;
+            gCoordinator.AddComponent(entity, health);
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            gCoordinator.AdvanceTick();
+            systems.healthSystem->Update(TICK_DT);
+        });
+    });
+
+    registry.AddSizes("systems/Lifetime", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Lifetime{1e9f});
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            gCoordinator.AdvanceTick();
+            systems.lifetimeSystem->Update(TICK_DT);
+        });
+    });
+
+    registry.AddSizes("systems/Boundary", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Spread(i, count));
+            Boundary boundary;
+            boundary.wrap = (i % 2) == 0;
+            gCoordinator.AddComponent(entity, boundary);
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            systems.boundarySystem->Update();
+        });
+    });
+
+    // Boundary derrière Movement : tous les Transform changent à chaque tick.
+    registry.AddSizes("systems/Boundary/Moving", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = gCoordinator.CreateEntity();
+            gCoordinator.AddComponent(entity, Spread(i, count));
+            gCoordinator.AddComponent(entity, Velocity{30.f, 0.f});
+            Boundary boundary;
+            boundary.wrap = true;
+            gCoordinator.AddComponent(entity, boundary);
+        }
+        state.SetItems(count);
+        state.Measure([&] {
+            gCoordinator.AdvanceChangeTick();
+            systems.movementSystem->Update(TICK_DT);
+            systems.boundarySystem->Update();
+        });
+    });
+
+    // Collision : cas courant (colliders répartis, aucun contact) puis
+    // pires cas où toutes les paires se chevauchent.
+    registry.AddSizes("systems/Collision/Spread", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            CreateShip(Spread(i, count), static_cast<int>(i % 2), 1.f);
+        }
+        state.SetItems(count * (count - 1) / 2);
+        state.Measure([&] { systems.collisionSystem->Update(TICK_DT); });
+    });
+
+    registry.AddSizes("systems/Collision/OverlapSameTeam", WORLD_SIZES, [](State& state, std::size_t count) {
+        OverlappingCollision(state, count, false);
+    });
+
+    registry.AddSizes("systems/Collision/OverlapOpposingTeams", WORLD_SIZES, [](State& state, std::size_t count) {
+        OverlappingCollision(state, count, true);
+    });
+
+    // Détection continue contre test aux positions de fin de tick : 1/10
+    // de vaisseaux, le reste en projectiles rapides (600 px/s) répartis.
+    for (bool continuous : {true, false}) {
+        std::string name = continuous ? "systems/Collision/Projectiles/Swept" : "systems/Collision/Projectiles/Discrete";
+        registry.AddSizes(name, WORLD_SIZES, [continuous](State& state, std::size_t count) {
+            SystemRefs systems = InitECS();
+            systems.collisionSystem->SetContinuous(continuous);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (i % 10 == 0) {
+                    Entity ship = CreateShip(Spread(i, count), 1, 20.f);
+                    gCoordinator.WriteComponent<Health>(ship).invincible = true;
+                    continue;
+                }
+                Entity bullet = gCoordinator.CreateEntity();
+                gCoordinator.AddComponent(bullet, Spread(i, count));
+                gCoordinator.AddComponent(bullet, Velocity{600.f, static_cast<float>(i % 7) * 20.f - 60.f});
+                Collider collider;
+                collider.radius = 5.f;
+                gCoordinator.AddComponent(bullet, collider);
+                gCoordinator.AddComponent(bullet, Team{0});
+                gCoordinator.AddComponent(bullet, Damager{});
+            }
+            state.SetItems(count);
+            state.Measure([&] {
+                gCoordinator.AdvanceTick();
+                systems.collisionSystem->Update(TICK_DT);
+                gCoordinator.Events<DamageEvent>().Swap();
+            });
+        });
+    }
+
+    // Tir en régime stable : ~taille projectiles vivants (un tir tous les
+    // 10 ticks par spawner, 3 s de vie), avec et sans recyclage, projectiles
+    // balistiques ou déplacés par MovementSystem (/Integrated).
+    for (bool pooled : {true, false}) for (bool ballistic : {true, false}) {
+        std::string name = pooled ? "systems/ProjectileFire/Pooled" : "systems/ProjectileFire/Unpooled";
+        if (!ballistic) {
+            name += "/Integrated";
+        }
+        registry.AddSizes(name, {1000, 3600}, [pooled, ballistic](State& state, std::size_t bullets) {
+            SystemRefs systems = InitECS();
+            systems.spawnerSystem->SetProjectilePooling(pooled);
+            systems.spawnerSystem->SetBallisticProjectiles(ballistic);
+            std::size_t spawners = bullets / 18;
+            for (std::size_t i = 0; i < spawners; ++i) {
+                Entity entity = gCoordinator.CreateEntity();
+                gCoordinator.AddComponent(entity, Transform{20.f + static_cast<float>(i % 20) * 30.f,
+                    20.f + static_cast<float>(i / 20) * 40.f, 0.f});
+                gCoordinator.AddComponent(entity, Team{0});
+                Spawner spawner;
+                spawner.spawnCooldown = 10.f * TICK_DT - 1e-4f;
+                spawner.spawnTimer = static_cast<float>(i % 10) * TICK_DT;
+                spawner.spawnVelocityX = 50.f;
+                spawner.spawnVelocityY = 0.f;
+                gCoordinator.AddComponent(entity, spawner);
+            }
+            auto tick = [&] {
+                gCoordinator.AdvanceChangeTick();
+                gCoordinator.AdvanceTick();
+                systems.spawnerSystem->Update(TICK_DT);
+                systems.movementSystem->Update(TICK_DT);
+                systems.lifetimeSystem->Update(TICK_DT);
+                systems.boundarySystem->Update();
+                systems.ballisticSystem->Update();
+                gCoordinator.ProcessDestructions();
+            };
+            for (int i = 0; i < 400; ++i) {
+                tick();
+            }
+            state.SetItems(spawners / 10);
+            state.Measure(tick);
+        });
+    }
+
+    registry.AddSizes("systems/Match", {64, 256}, [](State& state, std::size_t enemies) {
+        Match(state, enemies, MemoryPolicy{});
+    });
+
+    // Même partie, composants en huge pages de 2 Mio, puis en plus liés au
+    // nœud NUMA du thread de simulation (comparer temps et dTLB/it).
+    registry.Add("systems/Match/256/HugePages", [](State& state) {
+        MemoryPolicy memory;
+        memory.hugePages = true;
+        Match(state, 256, memory);
+    });
+    registry.Add("systems/Match/256/HugePagesLocalNode", [](State& state) {
+        MemoryPolicy memory;
+        memory.hugePages = true;
+        memory.numaNode = MemoryPolicy::CURRENT_NODE;
+        Match(state, 256, memory);
+    });
+
+    // Tick complet (StepECS) sur une scène mixte sans destruction.
+    registry.AddSizes("systems/StepECS", WORLD_SIZES, [](State& state, std::size_t count) {
+        SystemRefs systems = InitECS();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity entity = CreateShip(Spread(i, count), static_cast<int>(i % 2), 1.f);
+            gCoordinator.WriteComponent<Health>(entity).invincible = true;
+            Boundary boundary;
+            boundary.wrap = true;
+            gCoordinator.AddComponent(entity, boundary);
+            if (i % 2) {
+                gCoordinator.AddComponent(entity, AIController{});
+            } else {
+                gCoordinator.AddComponent(entity, PlayerInput{static_cast<int>(i % 9) + 1, false});
+            }
+        }
+        state.SetItems(count);
+        state.Measure([&] { StepECS(systems, TICK_DT); });
+    });
+}
+
+} // namespace bench
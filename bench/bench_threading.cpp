@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "threadPool.hpp"
+
+namespace bench {
+
+namespace {
+
+// Au moins deux workers : sans voleur, /StealLatency ne finirait pas.
+std::size_t PoolThreads()
+{
+    return std::max<std::size_t>(2, std::thread::hardware_concurrency());
+}
+
+// Lance `task` sur un worker et attend sans aider : le thread appelant ne
+// doit pas l'exécuter lui-même (ses soumissions iraient dans la file
+// d'injection, pas dans une deque).
+template <typename Task>
+void RunOnWorker(ThreadPool& pool, Task&& task)
+{
+    std::atomic<bool> done{false};
+    pool.submit([&] {
+        task();
+        done.store(true, std::memory_order_release);
+    });
+    while (!done.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+void RegisterThreadingBenchmarks(Registry& registry)
+{
+    // Débit, tâches vides soumises depuis un thread extérieur (file
+    // d'injection), le thread appelant aidant pendant l'attente.
+    registry.AddSizes("threading/ThreadPool/Submit", {1000, 100000}, [](State& state, std::size_t count) {
+        ThreadPool pool({PoolThreads()});
+        std::atomic<std::size_t> ran{0};
+        state.SetItems(count);
+        state.Measure([&] {
+            TaskGroup group(pool);
+            for (std::size_t i = 0; i < count; ++i) {
+                group.run([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+            group.wait();
+        });
+        DoNotOptimize(ran.load());
+    });
+
+    // Débit, tâches créées par une tâche du pool : deque du worker, les
+    // autres volent (chemin de l'ordonnanceur ECS et des salles).
+    registry.AddSizes("threading/ThreadPool/Spawn", {1000, 100000}, [](State& state, std::size_t count) {
+        ThreadPool pool({PoolThreads()});
+        std::atomic<std::size_t> ran{0};
+        state.SetItems(count);
+        state.Measure([&] {
+            RunOnWorker(pool, [&] {
+                TaskGroup group(pool);
+                for (std::size_t i = 0; i < count; ++i) {
+                    group.run([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+                }
+                group.wait();
+            });
+        });
+        DoNotOptimize(ran.load());
+    });
+
+    // Aller-retour d'une tâche vide jouée par un worker : base à
+    // retrancher de /StealLatency.
+    registry.Add("threading/ThreadPool/RoundTrip", [](State& state) {
+        ThreadPool pool({PoolThreads()});
+        state.SetItems(1);
+        state.Measure([&] { RunOnWorker(pool, [] {}); });
+    });
+
+    // Une tâche pousse une sous-tâche dans sa deque puis attend qu'un autre
+    // worker la vole (réveil compris si tous dormaient). Différence avec
+    // /RoundTrip : latence d'un vol.
+    registry.Add("threading/ThreadPool/StealLatency", [](State& state) {
+        ThreadPool pool({PoolThreads()});
+        std::uint64_t stealsBefore = pool.getStealCount();
+        state.SetItems(1);
+        state.Measure([&] {
+            RunOnWorker(pool, [&pool] {
+                std::atomic<bool> stolen{false};
+                pool.submit([&stolen] { stolen.store(true, std::memory_order_release); });
+                while (!stolen.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+            });
+        });
+        DoNotOptimize(pool.getStealCount() - stealsBefore);
+    });
+}
+
+} // namespace bench
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// Résultat d'un benchmark, temps en nanosecondes par itération.
+struct Result {
+    std::string name;
+    std::size_t iterations{};
+    double median{};
+    double min{};
+    double mean{};
+    double itemsPerSecond{};
+    double allocationsPerIteration{};
+    // Négatif si le compteur matériel est indisponible.
+    double dtlbMissesPerIteration{-1.0};
+    // Pic de mémoire résidente du processus à la fin de ce benchmark, en
+    // Ko (ne fait que croître d'un benchmark au suivant) ; -1 si inconnu.
+    long long peakRssKb{-1};
+    // Grandeurs propres au benchmark (ex: octets par tick), dans l'ordre
+    // où elles ont été données.
+    std::vector<std::pair<std::string, double>> counters{};
+};
+
+// Nombre d'allocations (operator new) depuis le lancement.
+std::size_t AllocationCount();
+
+// Défauts de TLB données (lectures) du thread courant, -1 si indisponible.
+long long DtlbMissCount();
+
+// Pic de mémoire résidente du processus depuis son lancement, en Ko
+// (getrusage), -1 si indisponible.
+long long PeakRssKb();
+
+// Passé à chaque benchmark : la mise en place se fait hors chrono, seul
+// le corps donné à Measure() est mesuré.
+class State {
+public:
+    State(std::string name, double minTime) : mName(std::move(name)), mMinTime(minTime) {}
+
+    // Nombre d'éléments traités par itération (pour items_per_second).
+    void SetItems(std::size_t items) { mItems = items; }
+
+    // Grandeur mesurée par le benchmark lui-même, reportée telle quelle
+    // (texte et JSON).
+    void SetCounter(const std::string& name, double value) { mResult.counters.emplace_back(name, value); }
+
+    // Exécute `body` par lots jusqu'à `minTime` secondes et garde la
+    // médiane des lots (robuste aux interruptions ponctuelles).
+    template <typename Body>
+    void Measure(Body&& body)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Calibrage : taille de lot visant ~1/20 du temps total.
+        std::size_t batch = 1;
+        for (;;) {
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < batch; ++i) {
+                body();
+            }
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (elapsed >= mMinTime / 20.0 || batch >= (std::size_t{1} << 30)) {
+                break;
+            }
+            batch *= 2;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(64);
+        double total = 0.0;
+        std::size_t allocations = 0;
+        long long dtlbMisses = 0;
+        while (total < mMinTime || samples.size() < 5) {
+            std::size_t allocationsBefore = AllocationCount();
+            long long dtlbBefore = DtlbMissCount();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < batch; ++i) {
+                body();
+            }
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            allocations += AllocationCount() - allocationsBefore;
+            dtlbMisses = AddMisses(dtlbMisses, dtlbBefore);
+            total += elapsed;
+            samples.push_back(elapsed * 1e9 / static_cast<double>(batch));
+        }
+
+        Finish(samples, total, allocations, dtlbMisses, batch);
+    }
+
+    // Variante pour les corps qui consomment leur état (ex: destruction) :
+    // `setup` est relancé avant chaque itération, hors chrono.
+    template <typename Setup, typename Body>
+    void MeasureEach(Setup&& setup, Body&& body)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<double> samples;
+        samples.reserve(64);
+        double total = 0.0;
+        std::size_t allocations = 0;
+        long long dtlbMisses = 0;
+        while (total < mMinTime || samples.size() < 5) {
+            setup();
+            std::size_t allocationsBefore = AllocationCount();
+            long long dtlbBefore = DtlbMissCount();
+            auto start = Clock::now();
+            body();
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            allocations += AllocationCount() - allocationsBefore;
+            dtlbMisses = AddMisses(dtlbMisses, dtlbBefore);
+            total += elapsed;
+            samples.push_back(elapsed * 1e9);
+        }
+        Finish(samples, total, allocations, dtlbMisses);
+    }
+
+    bool Measured() const { return mMeasured; }
+    const Result& GetResult() const { return mResult; }
+
+private:
+    // Cumule les défauts depuis `before` ; reste à -1 dès qu'une lecture
+    // échoue.
+    static long long AddMisses(long long total, long long before)
+    {
+        long long after = DtlbMissCount();
+        if (total < 0 || before < 0 || after < 0) {
+            return -1;
+        }
+        return total + (after - before);
+    }
+
+    // `allocations` inclut celles de samples.push_back (négligeables).
+    void Finish(std::vector<double>& samples, double total, std::size_t allocations, long long dtlbMisses,
+        std::size_t batch = 1)
+    {
+        std::sort(samples.begin(), samples.end());
+        mResult.name = mName;
+        mResult.iterations = batch * samples.size();
+        mResult.median = samples[samples.size() / 2];
+        mResult.min = samples.front();
+        mResult.mean = total * 1e9 / static_cast<double>(mResult.iterations);
+        mResult.itemsPerSecond = mItems > 0 ? static_cast<double>(mItems) * 1e9 / mResult.median : 0.0;
+        mResult.allocationsPerIteration = static_cast<double>(allocations) / static_cast<double>(mResult.iterations);
+        mResult.dtlbMissesPerIteration =
+            dtlbMisses < 0 ? -1.0 : static_cast<double>(dtlbMisses) / static_cast<double>(mResult.iterations);
+        mResult.peakRssKb = PeakRssKb();
+        mMeasured = true;
+    }
+
+    std::string mName;
+    double mMinTime;
+    std::size_t mItems{};
+    Result mResult{};
+    bool mMeasured{false};
+};
+
+using Function = std::function<void(State&)>;
+
+struct Entry {
+    std::string name;
+    Function function;
+};
+
+// Liste des benchmarks, dans l'ordre d'enregistrement.
+class Registry {
+public:
+    void Add(std::string name, Function function)
+    {
+        mEntries.push_back({std::move(name), std::move(function)});
+    }
+
+    // Déclinaison du même benchmark pour plusieurs tailles ("nom/N").
+    void AddSizes(const std::string& name, const std::vector<std::size_t>& sizes,
+        const std::function<void(State&, std::size_t)>& function)
+    {
+        for (std::size_t size : sizes) {
+            Add(name + "/" + std::to_string(size), [function, size](State& state) { function(state, size); });
+        }
+    }
+
+    const std::vector<Entry>& GetEntries() const { return mEntries; }
+
+private:
+    std::vector<Entry> mEntries{};
+};
+
+// Empêche le compilateur d'éliminer un calcul dont le résultat est inutilisé.
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Tailles de monde communes à tous les benchmarks ECS.
+inline const std::vector<std::size_t> WORLD_SIZES = {100, 1000, 5000};
+
+void RegisterEcsBenchmarks(Registry& registry);
+void RegisterSystemBenchmarks(Registry& registry);
+void RegisterNetworkBenchmarks(Registry& registry);
+void RegisterThreadingBenchmarks(Registry& registry);
+
+} // namespace bench
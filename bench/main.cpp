@@ -0,0 +1,144 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** bench main
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "types.hpp"
+
+#ifndef RTYPE_BUILD_TYPE
+#define RTYPE_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+
+std::string Escape(const std::string& text)
+{
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+// Format proche de Google Benchmark (--benchmark_format=json) pour
+// réutiliser les outils de comparaison existants.
+std::string ToJson(const std::vector<bench::Result>& results)
+{
+    char date[64] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    std::ostringstream json;
+    json.precision(10);
+    json << "{\n  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"build_type\": \"" << Escape(RTYPE_BUILD_TYPE) << "\",\n"
+         << "    \"max_entities\": " << ecs::MAX_ENTITIES << ",\n"
+         << "    \"peak_rss_kb\": " << bench::PeakRssKb() << "\n"
+         << "  },\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const bench::Result& result = results[i];
+        json << (i ? ",\n" : "\n")
+             << "    {\"name\": \"" << Escape(result.name) << "\", "
+             << "\"iterations\": " << result.iterations << ", "
+             << "\"real_time\": " << result.median << ", "
+             << "\"min_time\": " << result.min << ", "
+             << "\"mean_time\": " << result.mean << ", "
+             << "\"time_unit\": \"ns\"";
+        if (result.itemsPerSecond > 0.0) {
+            json << ", \"items_per_second\": " << result.itemsPerSecond;
+        }
+        json << ", \"allocs_per_iteration\": " << result.allocationsPerIteration;
+        if (result.dtlbMissesPerIteration >= 0.0) {
+            json << ", \"dtlb_misses_per_iteration\": " << result.dtlbMissesPerIteration;
+        }
+        if (result.peakRssKb >= 0) {
+            json << ", \"peak_rss_kb\": " << result.peakRssKb;
+        }
+        for (const auto& [name, value] : result.counters) {
+            json << ", \"" << Escape(name) << "\": " << value;
+        }
+        json << "}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+} // namespace
+
+// Usage : rtype_bench [--filter texte] [--min-time secondes] [--out fichier.json]
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string outPath;
+    double minTime = 0.2;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--filter") {
+            filter = argv[i + 1];
+        } else if (option == "--min-time") {
+            minTime = std::atof(argv[i + 1]);
+        } else if (option == "--out") {
+            outPath = argv[i + 1];
+        } else {
+            std::cerr << "Option inconnue : " << option << std::endl;
+            return 1;
+        }
+    }
+
+    bench::Registry registry;
+    bench::RegisterEcsBenchmarks(registry);
+    bench::RegisterSystemBenchmarks(registry);
+    bench::RegisterNetworkBenchmarks(registry);
+    bench::RegisterThreadingBenchmarks(registry);
+
+    std::vector<bench::Result> results;
+    for (const bench::Entry& entry : registry.GetEntries()) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        bench::State state(entry.name, minTime);
+        entry.function(state);
+        if (!state.Measured()) {
+            continue;
+        }
+        const bench::Result& result = state.GetResult();
+        std::fprintf(stderr, "%-45s %14.1f ns %12zu it %10.2f allocs/it", result.name.c_str(), result.median,
+            result.iterations, result.allocationsPerIteration);
+        if (result.dtlbMissesPerIteration >= 0.0) {
+            std::fprintf(stderr, " %12.1f dTLB/it", result.dtlbMissesPerIteration);
+        }
+        if (result.peakRssKb >= 0) {
+            std::fprintf(stderr, " %10lld Ko RSS max", result.peakRssKb);
+        }
+        for (const auto& [name, value] : result.counters) {
+            std::fprintf(stderr, " %12.1f %s", value, name.c_str());
+        }
+        std::fprintf(stderr, "\n");
+        results.push_back(result);
+    }
+
+    std::fprintf(stderr, "RSS max du processus : %lld Ko\n", bench::PeakRssKb());
+    std::string json = ToJson(results);
+    if (outPath.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream(outPath) << json;
+    }
+    return 0;
+}
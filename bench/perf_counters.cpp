@@ -0,0 +1,60 @@
+#include "benchmark.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+// Défauts de TLB données du thread de benchmark, lus sur un compteur
+// matériel perf_event ouvert au premier appel. Indisponible (noyau trop
+// restrictif, conteneur, VM sans PMU) : -1.
+namespace {
+
+#if defined(__linux__)
+int OpenDtlbCounter()
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+} // namespace
+
+long long bench::DtlbMissCount()
+{
+#if defined(__linux__)
+    static const int counter = OpenDtlbCounter();
+    long long value = 0;
+    if (counter < 0 || read(counter, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+        return -1;
+    }
+    return value;
+#else
+    return -1;
+#endif
+}
+
+// ru_maxrss est en Ko sous Linux (en octets sous macOS, non géré).
+long long bench::PeakRssKb()
+{
+#if defined(__linux__)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss;
+#else
+    return -1;
+#endif
+}
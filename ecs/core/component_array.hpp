@@ -1,70 +1,178 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cassert>
 #include <cstddef>
-#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
 
+#include "serialization.hpp"
 #include "types.hpp"
 
 namespace ecs {
 
+// Location of one saved component array inside a world buffer.
+struct ComponentBlock {
+    const std::uint8_t* entities{};
+    const std::uint8_t* data{};
+    std::size_t size{};
+};
+
 // Dense storage for a single component type with swap-delete removal.
+// Both directions of the entity/index mapping are fixed arrays, so adding
+// and removing components never touches the heap.
 template <typename T>
 class ComponentArray {
 public:
-    void InsertData(Entity entity, T component)
+    ComponentArray()
+    {
+        mEntityToIndex.fill(NO_INDEX);
+    }
+
+    void InsertData(Entity entity, T component, std::uint32_t tick = 0)
     {
-        auto [it, inserted] = mEntityToIndex.emplace(entity, mSize);
-        assert(inserted && "Component added twice");
+        assert(entity < MAX_ENTITIES && "Entity out of range");
+        assert(mEntityToIndex[entity] == NO_INDEX && "Component added twice");
 
-        std::size_t newIndex = it->second;
+        std::size_t newIndex = mSize;
+        mEntityToIndex[entity] = static_cast<std::uint32_t>(newIndex);
         mIndexToEntity[newIndex] = entity;
         mComponentArray[newIndex] = std::move(component);
+        mChangeTicks[newIndex] = tick;
         ++mSize;
     }
 
     void RemoveData(Entity entity)
     {
-        auto it = mEntityToIndex.find(entity);
-        assert(it != mEntityToIndex.end() && "Removing non-existent component");
+        assert(Contains(entity) && "Removing non-existent component");
         assert(mSize > 0 && "Component storage empty");
 
-        std::size_t removedIndex = it->second;
+        std::size_t removedIndex = mEntityToIndex[entity];
         std::size_t lastIndex = mSize - 1;
 
         if (removedIndex != lastIndex) {
             Entity movedEntity = mIndexToEntity[lastIndex];
             mComponentArray[removedIndex] = std::move(mComponentArray[lastIndex]);
+            mChangeTicks[removedIndex] = mChangeTicks[lastIndex];
             mIndexToEntity[removedIndex] = movedEntity;
-            mEntityToIndex[movedEntity] = removedIndex;
+            mEntityToIndex[movedEntity] = static_cast<std::uint32_t>(removedIndex);
         }
 
-        mEntityToIndex.erase(it);
+        mEntityToIndex[entity] = NO_INDEX;
         mIndexToEntity[lastIndex] = Entity{};
         --mSize;
     }
 
     T& GetData(Entity entity)
     {
-        auto it = mEntityToIndex.find(entity);
-        assert(it != mEntityToIndex.end() && "Retrieving non-existent component");
-        return mComponentArray[it->second];
+        assert(Contains(entity) && "Retrieving non-existent component");
+        return mComponentArray[mEntityToIndex[entity]];
+    }
+
+    // Mutable access that records `tick` as the component's last change.
+    T& WriteData(Entity entity, std::uint32_t tick)
+    {
+        assert(Contains(entity) && "Writing non-existent component");
+        std::size_t index = mEntityToIndex[entity];
+        mChangeTicks[index] = tick;
+        return mComponentArray[index];
+    }
+
+    std::uint32_t GetChangeTick(Entity entity) const
+    {
+        assert(Contains(entity) && "Retrieving non-existent component");
+        return mChangeTicks[mEntityToIndex[entity]];
+    }
+
+    // Calls func(entity, component) for components changed after `tick`;
+    // a linear pass over the dense range, no lookups.
+    template <typename Func>
+    void ForEachChangedSince(std::uint32_t tick, Func&& func) const
+    {
+        for (std::size_t index = 0; index < mSize; ++index) {
+            if (mChangeTicks[index] > tick) {
+                func(mIndexToEntity[index], mComponentArray[index]);
+            }
+        }
     }
 
     void EntityDestroyed(Entity entity)
     {
-        auto it = mEntityToIndex.find(entity);
-        if (it != mEntityToIndex.end()) {
+        if (Contains(entity)) {
             RemoveData(entity);
         }
     }
 
+    // Writes the dense range and its owners as two aligned raw blocks.
+    void Save(BinaryWriter& writer) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable components can be saved");
+        writer.WritePod(static_cast<std::uint64_t>(mSize));
+        writer.Write(mIndexToEntity.data(), mSize * sizeof(Entity));
+        writer.Align();
+        writer.Write(mComponentArray.data(), mSize * sizeof(T));
+        writer.Align();
+    }
+
+    // Validates a block written by Save; Apply() then copies it in.
+    static bool Parse(BinaryReader& reader, ComponentBlock& block)
+    {
+        std::uint64_t size = 0;
+        if (!reader.ReadPod(size) || size > MAX_ENTITIES) {
+            return false;
+        }
+        block.size = static_cast<std::size_t>(size);
+        block.entities = reader.Take(block.size * sizeof(Entity));
+        reader.Align();
+        block.data = reader.Take(block.size * sizeof(T));
+        reader.Align();
+        if (reader.Failed()) {
+            return false;
+        }
+        // Owners index the entity map: each must be in range and unique.
+        std::bitset<MAX_ENTITIES> seen;
+        for (std::size_t index = 0; index < block.size; ++index) {
+            Entity entity;
+            std::memcpy(&entity, block.entities + index * sizeof(Entity), sizeof(Entity));
+            if (entity >= MAX_ENTITIES || seen.test(entity)) {
+                return false;
+            }
+            seen.set(entity);
+        }
+        return true;
+    }
+
+    // Loaded components count as changed at `tick`.
+    void Apply(const ComponentBlock& block, std::uint32_t tick)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable components can be loaded");
+        std::memcpy(mIndexToEntity.data(), block.entities, block.size * sizeof(Entity));
+        std::memcpy(static_cast<void*>(mComponentArray.data()), block.data, block.size * sizeof(T));
+        mSize = block.size;
+        std::fill(mChangeTicks.begin(), mChangeTicks.begin() + static_cast<std::ptrdiff_t>(mSize), tick);
+
+        mEntityToIndex.fill(NO_INDEX);
+        for (std::size_t index = 0; index < mSize; ++index) {
+            mEntityToIndex[mIndexToEntity[index]] = static_cast<std::uint32_t>(index);
+        }
+    }
+
 private:
+    static constexpr std::uint32_t NO_INDEX = MAX_ENTITIES;
+
+    bool Contains(Entity entity) const
+    {
+        return entity < MAX_ENTITIES && mEntityToIndex[entity] != NO_INDEX;
+    }
+
     std::array<T, MAX_ENTITIES> mComponentArray{};
     std::array<Entity, MAX_ENTITIES> mIndexToEntity{};
-    std::unordered_map<Entity, std::size_t> mEntityToIndex{};
+    std::array<std::uint32_t, MAX_ENTITIES> mChangeTicks{};
+    std::array<std::uint32_t, MAX_ENTITIES> mEntityToIndex{};
     std::size_t mSize{};
 };
 
@@ -3,22 +3,29 @@
 #include <array>
 #include <cassert>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
 #include <utility>
 
 #include "component_array.hpp"
+#include "world_memory.hpp"
 
 namespace ecs {
 
 // Handles component registrations and per-type storage.
 class ComponentManager {
 public:
-    ComponentManager()
+    // Arrays are placed in `heap` when given (see MemoryPolicy); it must
+    // outlive the manager.
+    explicit ComponentManager(WorldHeap* heap = nullptr) : mHeap(heap)
     {
         mDestroyCallbacks.fill(nullptr);
     }
 
+    static_assert(MAX_COMPONENTS <= 64, "Signatures are walked as one 64-bit word");
+
     template <typename T>
     void RegisterComponent()
     {
@@ -27,10 +34,15 @@ public:
         assert(mNextComponentType < MAX_COMPONENTS && "Too many component types");
 
         ComponentType type = mNextComponentType++;
-        auto array = std::make_shared<ComponentArray<T>>();
         mComponentTypes[typeName] = type;
-        mComponentArrays[type] = std::static_pointer_cast<void>(array);
+        mComponentArrays[type] = CreateArray<T>();
         mDestroyCallbacks[type] = &ComponentManager::EntityDestroyedInvoker<T>;
+        mComponentSizes[type] = sizeof(T);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            mSaveCallbacks[type] = &ComponentManager::SaveInvoker<T>;
+            mParseCallbacks[type] = &ComponentArray<T>::Parse;
+            mApplyCallbacks[type] = &ComponentManager::ApplyInvoker<T>;
+        }
     }
 
     template <typename T>
@@ -45,7 +57,7 @@ public:
     template <typename T>
     void AddComponent(Entity entity, T component)
     {
-        GetComponentArray<T>()->InsertData(entity, std::move(component));
+        GetComponentArray<T>()->InsertData(entity, std::move(component), mChangeTick);
     }
 
     template <typename T>
@@ -60,34 +72,136 @@ public:
         return GetComponentArray<T>()->GetData(entity);
     }
 
-    void EntityDestroyed(Entity entity)
+    template <typename T>
+    T& WriteComponent(Entity entity)
+    {
+        return GetComponentArray<T>()->WriteData(entity, mChangeTick);
+    }
+
+    template <typename T>
+    bool ChangedSince(Entity entity, std::uint32_t tick)
+    {
+        return GetComponentArray<T>()->GetChangeTick(entity) > tick;
+    }
+
+    template <typename T, typename Func>
+    void ForEachChanged(std::uint32_t tick, Func&& func)
+    {
+        GetComponentArray<T>()->ForEachChangedSince(tick, std::forward<Func>(func));
+    }
+
+    // Writes and additions are stamped with the current change tick.
+    std::uint32_t AdvanceChangeTick()
+    {
+        return ++mChangeTick;
+    }
+
+    std::uint32_t GetChangeTick() const
+    {
+        return mChangeTick;
+    }
+
+    // Only visits the arrays named by the entity's signature.
+    void EntityDestroyed(Entity entity, Signature signature)
+    {
+        for (std::uint64_t bits = signature.to_ullong(); bits != 0; bits &= bits - 1) {
+            auto type = static_cast<ComponentType>(LowestSetBit(bits));
+            mDestroyCallbacks[type](mComponentArrays[type].get(), entity);
+        }
+    }
+
+    // Fails if a registered component is not trivially copyable.
+    bool Save(BinaryWriter& writer) const
     {
+        writer.WritePod(static_cast<std::uint32_t>(mNextComponentType));
         for (ComponentType type = 0; type < mNextComponentType; ++type) {
-            if (auto& storage = mComponentArrays[type]; storage && mDestroyCallbacks[type]) {
-                mDestroyCallbacks[type](storage.get(), entity);
+            if (!mSaveCallbacks[type]) {
+                return false;
             }
+            writer.WritePod(static_cast<std::uint32_t>(mComponentSizes[type]));
+            mSaveCallbacks[type](mComponentArrays[type].get(), writer);
         }
+        return true;
+    }
+
+    // Components must be registered in the same order as when saved.
+    // Nothing is modified unless every array validates.
+    bool Load(BinaryReader& reader)
+    {
+        std::uint32_t count = 0;
+        if (!reader.ReadPod(count) || count != mNextComponentType) {
+            return false;
+        }
+
+        std::array<ComponentBlock, MAX_COMPONENTS> blocks{};
+        for (ComponentType type = 0; type < mNextComponentType; ++type) {
+            std::uint32_t size = 0;
+            if (!reader.ReadPod(size) || size != mComponentSizes[type] || !mParseCallbacks[type] ||
+                !mParseCallbacks[type](reader, blocks[type])) {
+                return false;
+            }
+        }
+        ++mChangeTick;
+        for (ComponentType type = 0; type < mNextComponentType; ++type) {
+            mApplyCallbacks[type](mComponentArrays[type].get(), blocks[type], mChangeTick);
+        }
+        return true;
     }
 
 private:
     std::unordered_map<std::type_index, ComponentType> mComponentTypes{};
     std::array<std::shared_ptr<void>, MAX_COMPONENTS> mComponentArrays{};
     std::array<void (*)(void*, Entity), MAX_COMPONENTS> mDestroyCallbacks{};
+    std::array<std::size_t, MAX_COMPONENTS> mComponentSizes{};
+    std::array<void (*)(const void*, BinaryWriter&), MAX_COMPONENTS> mSaveCallbacks{};
+    std::array<bool (*)(BinaryReader&, ComponentBlock&), MAX_COMPONENTS> mParseCallbacks{};
+    std::array<void (*)(void*, const ComponentBlock&, std::uint32_t), MAX_COMPONENTS> mApplyCallbacks{};
     ComponentType mNextComponentType{};
+    std::uint32_t mChangeTick{1};
+    WorldHeap* mHeap{nullptr};
+
+    // Cache-line aligned in the world heap; the regular heap when there is
+    // none or it is full.
+    template <typename T>
+    std::shared_ptr<void> CreateArray()
+    {
+        constexpr std::size_t ALIGNMENT = alignof(ComponentArray<T>) > 64 ? alignof(ComponentArray<T>) : 64;
+        if (mHeap) {
+            if (void* memory = mHeap->Allocate(sizeof(ComponentArray<T>), ALIGNMENT)) {
+                return std::shared_ptr<void>(new (memory) ComponentArray<T>(),
+                    [](void* array) { static_cast<ComponentArray<T>*>(array)->~ComponentArray(); });
+            }
+        }
+        return std::make_shared<ComponentArray<T>>();
+    }
+
+    template <typename T>
+    static void SaveInvoker(const void* storage, BinaryWriter& writer)
+    {
+        static_cast<const ComponentArray<T>*>(storage)->Save(writer);
+    }
+
+    template <typename T>
+    static void ApplyInvoker(void* storage, const ComponentBlock& block, std::uint32_t tick)
+    {
+        static_cast<ComponentArray<T>*>(storage)->Apply(block, tick);
+    }
 
     template <typename T>
     static void EntityDestroyedInvoker(void* storage, Entity entity)
     {
         auto* typedArray = static_cast<ComponentArray<T>*>(storage);
         assert(typedArray && "Component storage missing");
-        typedArray->EntityDestroyed(entity);
+        typedArray->RemoveData(entity);
     }
 
+    // Raw pointer: the manager owns the arrays, and copying the shared_ptr
+    // would cost two atomic operations per component access.
     template <typename T>
-    std::shared_ptr<ComponentArray<T>> GetComponentArray()
+    ComponentArray<T>* GetComponentArray()
     {
         ComponentType type = GetComponentType<T>();
-        auto array = std::static_pointer_cast<ComponentArray<T>>(mComponentArrays[type]);
+        auto* array = static_cast<ComponentArray<T>*>(mComponentArrays[type].get());
         assert(array && "Component array missing");
         return array;
     }
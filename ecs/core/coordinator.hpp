@@ -1,23 +1,41 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
-#include <queue>
 #include <utility>
+#include <vector>
 
 #include "component_manager.hpp"
+#include "enabled_view.hpp"
 #include "entity_manager.hpp"
+#include "entity_pool.hpp"
+#include "event_bus.hpp"
+#include "frame_arena.hpp"
+#include "observer.hpp"
+#include "serialization.hpp"
 #include "system_manager.hpp"
+#include "world_memory.hpp"
 
 namespace ecs {
 
 // High-level facade combining managers.
 class Coordinator {
 public:
-    void Init()
+    // `memory` places component storage (huge pages, NUMA node); call from
+    // the thread that will run the world when binding to CURRENT_NODE.
+    void Init(const MemoryPolicy& memory = {})
     {
+        // The arrays of the previous world live in its heap.
+        mComponentManager.reset();
+        mHeap = memory.IsDefault() ? nullptr : std::make_unique<WorldHeap>(memory);
         mEntityManager = std::make_unique<EntityManager>();
-        mComponentManager = std::make_unique<ComponentManager>();
+        mComponentManager = std::make_unique<ComponentManager>(mHeap.get());
         mSystemManager = std::make_unique<SystemManager>();
+        mObservers = std::make_unique<ObserverRegistry>();
+        mEvents = std::make_unique<EventBus>();
+        mFrame = std::make_unique<FrameArena>();
+        mPools.clear();
+        mTick = 0;
     }
 
     Entity CreateEntity()
@@ -25,25 +43,141 @@ public:
         return mEntityManager->CreateEntity();
     }
 
+    // Immediate teardown: remove observers run at the next sync point,
+    // when the components are already gone.
     void DestroyEntity(Entity entity)
     {
-        mComponentManager->EntityDestroyed(entity);
-        mSystemManager->EntityDestroyed(entity);
-        mEntityManager->DestroyEntity(entity);
+        NotifySignatureChanged(entity, mEntityManager->GetSignature(entity), Signature{});
+        TearDown(entity);
     }
 
-    void RequestDestroyEntity(Entity entity)
+    // `buffer` is the caller's event buffer when several workers emit.
+    void RequestDestroyEntity(Entity entity, std::size_t buffer = 0)
     {
-        mEntitiesToDestroy.push(entity);
+        mEvents->Get<DestroyEvent>().Emit({entity}, buffer);
     }
 
+    // Sorted and deduplicated first: several systems may request the same
+    // entity in one tick, and ascending ids keep array accesses forward.
+    // Also a sync point: observers are flushed before teardown, so remove
+    // observers can still read the components of this batch. Destroys they
+    // request go to the next batch.
     void ProcessDestructions()
     {
-        while (!mEntitiesToDestroy.empty()) {
-            Entity entity = mEntitiesToDestroy.front();
-            mEntitiesToDestroy.pop();
-            DestroyEntity(entity);
+        auto& requests = mEvents->Get<DestroyEvent>();
+        requests.Swap();
+        for (const DestroyEvent& request : requests.Events()) {
+            mDestroyBatch.push_back(request.entity);
+        }
+        std::sort(mDestroyBatch.begin(), mDestroyBatch.end());
+        mDestroyBatch.erase(std::unique(mDestroyBatch.begin(), mDestroyBatch.end()), mDestroyBatch.end());
+        if (mObservers->Active()) {
+            for (Entity entity : mDestroyBatch) {
+                if (!IsPooled(entity)) {
+                    mObservers->SignatureChanged(entity, mEntityManager->GetSignature(entity), Signature{});
+                }
+            }
+            mObservers->Flush();
+        }
+        for (Entity entity : mDestroyBatch) {
+            if (!RecycleEntity(entity)) {
+                TearDown(entity);
+            }
+        }
+        mDestroyBatch.clear();
+    }
+
+    // Batched callbacks; see ObserverRegistry. Parking a pooled entity or
+    // disabling one is not a structural change and raises no event.
+    template <typename T>
+    void OnAdd(ObserverCallback callback)
+    {
+        mObservers->OnAdd(mComponentManager->GetComponentType<T>(), std::move(callback));
+    }
+
+    template <typename T>
+    void OnRemove(ObserverCallback callback)
+    {
+        mObservers->OnRemove(mComponentManager->GetComponentType<T>(), std::move(callback));
+    }
+
+    void OnMatch(Signature required, ObserverCallback onEnter, ObserverCallback onExit)
+    {
+        mObservers->OnMatch(required, std::move(onEnter), std::move(onExit));
+    }
+
+    // Explicit sync point for events raised outside ProcessDestructions().
+    void FlushObservers()
+    {
+        mObservers->Flush();
+    }
+
+    // Gameplay event queue of type T (see EventBus).
+    template <typename T>
+    EventQueue<T>& Events()
+    {
+        return mEvents->Get<T>();
+    }
+
+    // One write buffer per worker that emits events in parallel.
+    void SetEventBufferCount(std::size_t count)
+    {
+        mEvents->SetBufferCount(count);
+    }
+
+    // Entities tracked by a pool are parked on destroy requests instead of
+    // being torn down.
+    std::shared_ptr<EntityPool> CreatePool()
+    {
+        mPools.push_back(std::make_shared<EntityPool>());
+        return mPools.back();
+    }
+
+    // Tracked by a pool, whether parked or in use.
+    bool IsPooled(Entity entity) const
+    {
+        for (const auto& pool : mPools) {
+            if (pool->Owns(entity)) {
+                return true;
+            }
         }
+        return false;
+    }
+
+    // Parked by a destroy request and waiting in its pool. A pooled entity
+    // disabled with SetEntityEnabled() is paused, not parked.
+    bool IsParked(Entity entity) const
+    {
+        for (const auto& pool : mPools) {
+            if (pool->Owns(entity)) {
+                return pool->IsParked(entity);
+            }
+        }
+        return false;
+    }
+
+    void SetEntityEnabled(Entity entity, bool enabled)
+    {
+        mEntityManager->SetEnabled(entity, enabled);
+    }
+
+    bool IsEntityEnabled(Entity entity) const
+    {
+        return mEntityManager->IsEnabled(entity);
+    }
+
+    // Parks or resumes a group (room, wave) without touching signatures.
+    void SetEntitiesEnabled(const std::vector<Entity>& entities, bool enabled)
+    {
+        for (Entity entity : entities) {
+            mEntityManager->SetEnabled(entity, enabled);
+        }
+    }
+
+    // Systems iterate this instead of their raw entity list.
+    EnabledView Enabled(const std::vector<Entity>& entities) const
+    {
+        return EnabledView(entities, mEntityManager->GetDisabled());
     }
 
     template <typename T>
@@ -57,10 +191,12 @@ public:
     {
         mComponentManager->AddComponent<T>(entity, std::move(component));
 
-        Signature signature = mEntityManager->GetSignature(entity);
+        Signature previous = mEntityManager->GetSignature(entity);
+        Signature signature = previous;
         signature.set(mComponentManager->GetComponentType<T>(), true);
         mEntityManager->SetSignature(entity, signature);
         mSystemManager->EntitySignatureChanged(entity, signature);
+        NotifySignatureChanged(entity, previous, signature);
     }
 
     template <typename T>
@@ -68,18 +204,119 @@ public:
     {
         mComponentManager->RemoveComponent<T>(entity);
 
-        Signature signature = mEntityManager->GetSignature(entity);
+        Signature previous = mEntityManager->GetSignature(entity);
+        Signature signature = previous;
         signature.set(mComponentManager->GetComponentType<T>(), false);
         mEntityManager->SetSignature(entity, signature);
         mSystemManager->EntitySignatureChanged(entity, signature);
+        NotifySignatureChanged(entity, previous, signature);
     }
 
+    // Read-only: writes go through WriteComponent() so that change
+    // tracking sees them.
     template <typename T>
-    T& GetComponent(Entity entity)
+    const T& GetComponent(Entity entity)
     {
         return mComponentManager->GetComponent<T>(entity);
     }
 
+    // Mutable access recorded by change tracking.
+    template <typename T>
+    T& WriteComponent(Entity entity)
+    {
+        return mComponentManager->WriteComponent<T>(entity);
+    }
+
+    // Mutable access that change tracking does not see. Only for state a
+    // system keeps on the component it scans (deadlines, counters, current
+    // target): a stamped write would be reported back to that system by its
+    // next ForEachChanged scan.
+    template <typename T>
+    T& GetComponentUntracked(Entity entity)
+    {
+        return mComponentManager->GetComponent<T>(entity);
+    }
+
+    // Change ticks are a counter of their own, not simulation ticks: they
+    // advance at every step start and at every MarkChangesSeen(), so several
+    // per step. `tick` is a value the caller got from GetChangeTick() or
+    // MarkChangesSeen() and keeps as its own cursor.
+
+    // True if the component was added or written after `tick`.
+    template <typename T>
+    bool ChangedSince(Entity entity, std::uint32_t tick)
+    {
+        return mComponentManager->ChangedSince<T>(entity, tick);
+    }
+
+    // Calls func(entity, const T&) for every T changed after `tick`.
+    template <typename T, typename Func>
+    void ForEachChanged(std::uint32_t tick, Func&& func)
+    {
+        mComponentManager->ForEachChanged<T>(tick, std::forward<Func>(func));
+    }
+
+    // Starts a new change tick and returns it. Writes made before the call
+    // compare older than writes made after it.
+    std::uint32_t AdvanceChangeTick()
+    {
+        return mComponentManager->AdvanceChangeTick();
+    }
+
+    // Tick stamped on writes made now.
+    std::uint32_t GetChangeTick() const
+    {
+        return mComponentManager->GetChangeTick();
+    }
+
+    // Ends a ForEachChanged scan: everything written so far counts as
+    // seen, and the change tick is advanced so that writes made later in
+    // the same step compare newer. Passing the result as `since` to the
+    // next scan visits every change exactly once.
+    std::uint32_t MarkChangesSeen()
+    {
+        std::uint32_t seen = mComponentManager->GetChangeTick();
+        mComponentManager->AdvanceChangeTick();
+        return seen;
+    }
+
+    // Simulation tick, advanced once per step and saved with the world.
+    // Deadlines (see TimerWheel) are expressed in these ticks. Also ends
+    // the lifetime of everything allocated from Frame().
+    std::uint32_t AdvanceTick()
+    {
+        mFrame->Reset();
+        return ++mTick;
+    }
+
+    // Per-tick arena for transient data, released by AdvanceTick().
+    FrameArena& Frame()
+    {
+        return *mFrame;
+    }
+
+    std::uint32_t GetTick() const
+    {
+        return mTick;
+    }
+
+    // What the memory policy given to Init() actually obtained.
+    MemoryStatus GetMemoryStatus() const
+    {
+        return mHeap ? mHeap->GetStatus() : MemoryStatus{};
+    }
+
+    Signature GetSignature(Entity entity) const
+    {
+        return mEntityManager->GetSignature(entity);
+    }
+
+    template <typename T>
+    bool HasComponent(Entity entity)
+    {
+        return mEntityManager->GetSignature(entity).test(mComponentManager->GetComponentType<T>());
+    }
+
     template <typename T>
     ComponentType GetComponentType()
     {
@@ -98,11 +335,133 @@ public:
         mSystemManager->SetSignature<T>(signature);
     }
 
+    // Serializes entities, signatures, system membership, pools and every
+    // component array.
+    bool SaveWorld(std::vector<std::uint8_t>& out)
+    {
+        BinaryWriter writer(out);
+        writer.WritePod(WORLD_MAGIC);
+        writer.WritePod(WORLD_FORMAT_VERSION);
+        writer.WritePod(static_cast<std::uint32_t>(MAX_ENTITIES));
+        writer.WritePod(static_cast<std::uint32_t>(MAX_COMPONENTS));
+        writer.WritePod(mTick);
+        mEntityManager->Save(writer);
+        writer.Align();
+        mSystemManager->Save(writer);
+        writer.Align();
+        writer.WritePod(static_cast<std::uint32_t>(mPools.size()));
+        for (const auto& pool : mPools) {
+            pool->Save(writer);
+        }
+        writer.Align();
+        return mComponentManager->Save(writer);
+    }
+
+    // Restores a world saved with the same component, system and pool
+    // registration order. Nothing changes if the data does not validate.
+    bool LoadWorld(const std::uint8_t* data, std::size_t size)
+    {
+        BinaryReader reader(data, size);
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint32_t maxEntities = 0;
+        std::uint32_t maxComponents = 0;
+        std::uint32_t tick = 0;
+        reader.ReadPod(magic);
+        reader.ReadPod(version);
+        reader.ReadPod(maxEntities);
+        reader.ReadPod(maxComponents);
+        reader.ReadPod(tick);
+        if (reader.Failed() || magic != WORLD_MAGIC || version != WORLD_FORMAT_VERSION ||
+            maxEntities != MAX_ENTITIES || maxComponents != MAX_COMPONENTS) {
+            return false;
+        }
+
+        auto entityManager = std::make_unique<EntityManager>();
+        if (!entityManager->Load(reader)) {
+            return false;
+        }
+        reader.Align();
+        std::vector<std::vector<Entity>> systemEntities;
+        if (!mSystemManager->Parse(reader, systemEntities)) {
+            return false;
+        }
+        reader.Align();
+        std::uint32_t poolCount = 0;
+        if (!reader.ReadPod(poolCount) || poolCount != mPools.size()) {
+            return false;
+        }
+        std::vector<EntityPool> pools(poolCount);
+        for (auto& pool : pools) {
+            if (!pool.Load(reader)) {
+                return false;
+            }
+        }
+        reader.Align();
+        if (!mComponentManager->Load(reader)) {
+            return false;
+        }
+        mEntityManager = std::move(entityManager);
+        mSystemManager->Apply(systemEntities);
+        for (std::size_t i = 0; i < pools.size(); ++i) {
+            *mPools[i] = std::move(pools[i]);
+        }
+        mTick = tick;
+        // Pending events name entities of the replaced world.
+        mEvents->Clear();
+        // Observers see later changes only, not the loaded state.
+        mObservers->Clear();
+        return true;
+    }
+
 private:
+    void TearDown(Entity entity)
+    {
+        for (auto& pool : mPools) {
+            if (pool->Owns(entity)) {
+                pool->Forget(entity);
+            }
+        }
+        Signature signature = mEntityManager->GetSignature(entity);
+        mComponentManager->EntityDestroyed(entity, signature);
+        mSystemManager->EntityDestroyed(entity, signature);
+        mEntityManager->DestroyEntity(entity);
+    }
+
+    void NotifySignatureChanged(Entity entity, Signature previous, Signature signature)
+    {
+        if (mObservers->Active()) {
+            mObservers->SignatureChanged(entity, previous, signature);
+        }
+    }
+
+    bool RecycleEntity(Entity entity)
+    {
+        for (auto& pool : mPools) {
+            if (pool->Owns(entity)) {
+                // Several systems may request the same entity in one tick.
+                // A paused entity is parked too, and stays disabled.
+                if (!pool->IsParked(entity)) {
+                    mEntityManager->SetEnabled(entity, false);
+                    pool->Park(entity);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Declared first: destroyed after the component arrays it holds.
+    std::unique_ptr<WorldHeap> mHeap{};
     std::unique_ptr<EntityManager> mEntityManager{};
     std::unique_ptr<ComponentManager> mComponentManager{};
     std::unique_ptr<SystemManager> mSystemManager{};
-    std::queue<Entity> mEntitiesToDestroy{};
+    std::unique_ptr<ObserverRegistry> mObservers{};
+    std::unique_ptr<EventBus> mEvents{};
+    std::unique_ptr<FrameArena> mFrame{};
+    std::vector<Entity> mDestroyBatch{};
+    std::vector<std::shared_ptr<EntityPool>> mPools{};
+    std::uint32_t mTick{0};
 };
 
 } // namespace ecs
\ No newline at end of file
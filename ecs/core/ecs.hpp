@@ -3,10 +3,17 @@
 #include "component_array.hpp"
 #include "component_manager.hpp"
 #include "coordinator.hpp"
+#include "enabled_view.hpp"
 #include "entity_manager.hpp"
+#include "entity_pool.hpp"
+#include "event_bus.hpp"
+#include "frame_arena.hpp"
+#include "observer.hpp"
 #include "system.hpp"
 #include "system_manager.hpp"
+#include "timer_wheel.hpp"
 #include "types.hpp"
+#include "world_memory.hpp"
 
 namespace ecs {
 
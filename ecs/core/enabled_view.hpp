@@ -0,0 +1,61 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <vector>
+
+#include "types.hpp"
+
+namespace ecs {
+
+// Iterates an entity list, skipping entities whose disabled bit is set.
+class EnabledView {
+public:
+    class Iterator {
+    public:
+        Iterator(const Entity* current, const Entity* end, const std::bitset<MAX_ENTITIES>* disabled)
+            : mCurrent(current), mEnd(end), mDisabled(disabled)
+        {
+            SkipDisabled();
+        }
+
+        Entity operator*() const { return *mCurrent; }
+
+        Iterator& operator++()
+        {
+            ++mCurrent;
+            SkipDisabled();
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const { return mCurrent != other.mCurrent; }
+        bool operator==(const Iterator& other) const { return mCurrent == other.mCurrent; }
+
+    private:
+        void SkipDisabled()
+        {
+            while (mCurrent != mEnd && mDisabled->test(*mCurrent)) {
+                ++mCurrent;
+            }
+        }
+
+        const Entity* mCurrent;
+        const Entity* mEnd;
+        const std::bitset<MAX_ENTITIES>* mDisabled;
+    };
+
+    EnabledView(const std::vector<Entity>& entities, const std::bitset<MAX_ENTITIES>& disabled)
+        : mBegin(entities.data()), mEnd(entities.data() + entities.size()), mDisabled(&disabled)
+    {
+    }
+
+    Iterator begin() const { return Iterator(mBegin, mEnd, mDisabled); }
+    Iterator end() const { return Iterator(mEnd, mEnd, mDisabled); }
+
+private:
+    const Entity* mBegin;
+    const Entity* mEnd;
+    const std::bitset<MAX_ENTITIES>* mDisabled;
+};
+
+} // namespace ecs
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cassert>
-#include <queue>
+#include <cstring>
+#include <vector>
 
+#include "serialization.hpp"
 #include "types.hpp"
 
 namespace ecs {
@@ -14,15 +17,15 @@ public:
     EntityManager()
     {
         for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
-            mAvailableEntities.push(entity);
+            mAvailableEntities[entity] = entity;
         }
     }
 
     Entity CreateEntity()
     {
         assert(mLivingEntityCount < MAX_ENTITIES && "Too many entities");
-        Entity id = mAvailableEntities.front();
-        mAvailableEntities.pop();
+        Entity id = mAvailableEntities[mAvailableHead];
+        mAvailableHead = (mAvailableHead + 1) % MAX_ENTITIES;
         ++mLivingEntityCount;
         return id;
     }
@@ -31,7 +34,9 @@ public:
     {
         assert(entity < MAX_ENTITIES && "Entity out of range");
         mSignatures[entity].reset();
-        mAvailableEntities.push(entity);
+        mDisabled.reset(entity);
+        // FIFO reuse: the slot after the last free id, modulo the capacity.
+        mAvailableEntities[(mAvailableHead + MAX_ENTITIES - mLivingEntityCount) % MAX_ENTITIES] = entity;
         --mLivingEntityCount;
     }
 
@@ -47,9 +52,91 @@ public:
         return mSignatures[entity];
     }
 
+    // Disabled entities keep their components but are skipped by systems.
+    void SetEnabled(Entity entity, bool enabled)
+    {
+        assert(entity < MAX_ENTITIES && "Entity out of range");
+        mDisabled.set(entity, !enabled);
+    }
+
+    bool IsEnabled(Entity entity) const
+    {
+        assert(entity < MAX_ENTITIES && "Entity out of range");
+        return !mDisabled.test(entity);
+    }
+
+    const std::bitset<MAX_ENTITIES>& GetDisabled() const
+    {
+        return mDisabled;
+    }
+
+    void Save(BinaryWriter& writer) const
+    {
+        static_assert(MAX_COMPONENTS <= 64, "Signatures are saved as 64-bit words");
+        std::vector<Entity> available(MAX_ENTITIES - mLivingEntityCount);
+        for (std::size_t i = 0; i < available.size(); ++i) {
+            available[i] = mAvailableEntities[(mAvailableHead + i) % MAX_ENTITIES];
+        }
+
+        std::vector<std::uint64_t> signatures(MAX_ENTITIES);
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            signatures[entity] = mSignatures[entity].to_ullong();
+        }
+
+        std::vector<std::uint64_t> disabled(DISABLED_WORDS);
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            disabled[entity / 64] |= static_cast<std::uint64_t>(mDisabled.test(entity)) << (entity % 64);
+        }
+
+        writer.WritePod(mLivingEntityCount);
+        writer.WritePod(static_cast<std::uint32_t>(available.size()));
+        writer.Write(available.data(), available.size() * sizeof(Entity));
+        writer.Align();
+        writer.Write(signatures.data(), signatures.size() * sizeof(std::uint64_t));
+        writer.Write(disabled.data(), disabled.size() * sizeof(std::uint64_t));
+    }
+
+    // Intended for a freshly constructed manager.
+    bool Load(BinaryReader& reader)
+    {
+        std::uint32_t living = 0;
+        std::uint32_t availableCount = 0;
+        if (!reader.ReadPod(living) || !reader.ReadPod(availableCount) ||
+            living > MAX_ENTITIES || availableCount != MAX_ENTITIES - living) {
+            return false;
+        }
+        const std::uint8_t* available = reader.Take(availableCount * sizeof(Entity));
+        reader.Align();
+        const std::uint8_t* signatures = reader.Take(MAX_ENTITIES * sizeof(std::uint64_t));
+        const std::uint8_t* disabled = reader.Take(DISABLED_WORDS * sizeof(std::uint64_t));
+        if (reader.Failed()) {
+            return false;
+        }
+
+        mAvailableHead = 0;
+        std::memcpy(mAvailableEntities.data(), available, availableCount * sizeof(Entity));
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            std::uint64_t bits;
+            std::memcpy(&bits, signatures + entity * sizeof(std::uint64_t), sizeof(bits));
+            mSignatures[entity] = Signature(bits);
+        }
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            std::uint64_t word;
+            std::memcpy(&word, disabled + (entity / 64) * sizeof(std::uint64_t), sizeof(word));
+            mDisabled.set(entity, (word >> (entity % 64)) & 1);
+        }
+        mLivingEntityCount = living;
+        return true;
+    }
+
 private:
-    std::queue<Entity> mAvailableEntities{};
+    static constexpr std::size_t DISABLED_WORDS = (MAX_ENTITIES + 63) / 64;
+
+    // Free ids form a ring of MAX_ENTITIES - living entries from the head.
+    std::array<Entity, MAX_ENTITIES> mAvailableEntities{};
+    std::uint32_t mAvailableHead{};
     std::array<Signature, MAX_ENTITIES> mSignatures{};
+    std::bitset<MAX_ENTITIES> mDisabled{};
     std::uint32_t mLivingEntityCount{};
 };
 
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "serialization.hpp"
+#include "types.hpp"
+
+namespace ecs {
+
+// Set of entities recycled instead of destroyed: a destroy request parks
+// the entity (disabled, components kept) and Acquire() hands it back.
+class EntityPool {
+public:
+    void Track(Entity entity)
+    {
+        mMembers.set(entity);
+    }
+
+    bool Owns(Entity entity) const
+    {
+        return mMembers.test(entity);
+    }
+
+    bool IsParked(Entity entity) const
+    {
+        return mIsParked.test(entity);
+    }
+
+    void Park(Entity entity)
+    {
+        mParked.push_back(entity);
+        mIsParked.set(entity);
+    }
+
+    // Returns a parked entity, or MAX_ENTITIES if none is available.
+    Entity Acquire()
+    {
+        if (mParked.empty()) {
+            return MAX_ENTITIES;
+        }
+        Entity entity = mParked.back();
+        mParked.pop_back();
+        mIsParked.reset(entity);
+        return entity;
+    }
+
+    // Drops an entity that is really being destroyed.
+    void Forget(Entity entity)
+    {
+        mMembers.reset(entity);
+        if (mIsParked.test(entity)) {
+            mIsParked.reset(entity);
+            mParked.erase(std::remove(mParked.begin(), mParked.end(), entity), mParked.end());
+        }
+    }
+
+    std::size_t GetParkedCount() const { return mParked.size(); }
+
+    void Save(BinaryWriter& writer) const
+    {
+        writer.WritePod(static_cast<std::uint32_t>(mParked.size()));
+        writer.Write(mParked.data(), mParked.size() * sizeof(Entity));
+        for (Entity entity = 0; entity < MAX_ENTITIES; entity += 64) {
+            std::uint64_t word = 0;
+            for (Entity bit = 0; bit < 64 && entity + bit < MAX_ENTITIES; ++bit) {
+                word |= static_cast<std::uint64_t>(mMembers.test(entity + bit)) << bit;
+            }
+            writer.WritePod(word);
+        }
+    }
+
+    bool Load(BinaryReader& reader)
+    {
+        std::uint32_t parked = 0;
+        if (!reader.ReadPod(parked) || parked > MAX_ENTITIES) {
+            return false;
+        }
+        const std::uint8_t* data = reader.Take(parked * sizeof(Entity));
+        if (!data) {
+            return false;
+        }
+        std::bitset<MAX_ENTITIES> members;
+        for (Entity entity = 0; entity < MAX_ENTITIES; entity += 64) {
+            std::uint64_t word = 0;
+            if (!reader.ReadPod(word)) {
+                return false;
+            }
+            for (Entity bit = 0; bit < 64 && entity + bit < MAX_ENTITIES; ++bit) {
+                members.set(entity + bit, (word >> bit) & 1);
+            }
+        }
+        std::vector<Entity> list(parked);
+        if (parked > 0) {
+            std::memcpy(list.data(), data, parked * sizeof(Entity));
+        }
+        std::bitset<MAX_ENTITIES> isParked;
+        for (Entity entity : list) {
+            if (entity >= MAX_ENTITIES || !members.test(entity)) {
+                return false;
+            }
+            isParked.set(entity);
+        }
+        mParked = std::move(list);
+        mMembers = members;
+        mIsParked = isParked;
+        return true;
+    }
+
+private:
+    std::bitset<MAX_ENTITIES> mMembers{};
+    std::vector<Entity> mParked{};
+    // Same set as mParked: a disabled member may only be paused.
+    std::bitset<MAX_ENTITIES> mIsParked{};
+};
+
+} // namespace ecs
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "types.hpp"
+
+namespace ecs {
+
+// Destruction request; Coordinator::ProcessDestructions() consumes them.
+struct DestroyEvent {
+    Entity entity;
+};
+
+class IEventQueue {
+public:
+    virtual ~IEventQueue() = default;
+    virtual void SetBufferCount(std::size_t count) = 0;
+    virtual void Clear() = 0;
+};
+
+// Double-buffered queue of one event type. Producers append to their own
+// write buffer (one per worker, no locking); Swap() publishes everything
+// written so far, in buffer order, and drops what was published before.
+template <typename T>
+class EventQueue : public IEventQueue {
+public:
+    explicit EventQueue(std::size_t buffers = 1) : mWrite(buffers) {}
+
+    void Emit(const T& event, std::size_t buffer = 0)
+    {
+        assert(buffer < mWrite.size() && "Event buffer out of range");
+        mWrite[buffer].push_back(event);
+    }
+
+    void Swap()
+    {
+        mRead.clear();
+        for (auto& buffer : mWrite) {
+            mRead.insert(mRead.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+    }
+
+    // Published events; consumers may sort them in place.
+    std::vector<T>& Events() { return mRead; }
+
+    bool Pending() const
+    {
+        for (const auto& buffer : mWrite) {
+            if (!buffer.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void SetBufferCount(std::size_t count) override
+    {
+        assert(count > 0 && "An event queue needs at least one buffer");
+        // Events already written to dropped buffers stay pending.
+        for (std::size_t i = count; i < mWrite.size(); ++i) {
+            mWrite[0].insert(mWrite[0].end(), mWrite[i].begin(), mWrite[i].end());
+        }
+        mWrite.resize(count);
+    }
+
+    void Clear() override
+    {
+        for (auto& buffer : mWrite) {
+            buffer.clear();
+        }
+        mRead.clear();
+    }
+
+private:
+    std::vector<std::vector<T>> mWrite;
+    std::vector<T> mRead{};
+};
+
+// One EventQueue per event type. Queues are created on first access, which
+// must happen on the main thread; Emit() on distinct buffers is then safe
+// from workers.
+class EventBus {
+public:
+    template <typename T>
+    EventQueue<T>& Get()
+    {
+        std::type_index typeName(typeid(T));
+        auto it = mQueues.find(typeName);
+        if (it == mQueues.end()) {
+            it = mQueues.emplace(typeName, std::make_unique<EventQueue<T>>(mBufferCount)).first;
+        }
+        return static_cast<EventQueue<T>&>(*it->second);
+    }
+
+    void SetBufferCount(std::size_t count)
+    {
+        mBufferCount = count;
+        for (auto& [type, queue] : mQueues) {
+            queue->SetBufferCount(count);
+        }
+    }
+
+    std::size_t GetBufferCount() const { return mBufferCount; }
+
+    void Clear()
+    {
+        for (auto& [type, queue] : mQueues) {
+            queue->Clear();
+        }
+    }
+
+private:
+    std::unordered_map<std::type_index, std::unique_ptr<IEventQueue>> mQueues{};
+    std::size_t mBufferCount{1};
+};
+
+} // namespace ecs
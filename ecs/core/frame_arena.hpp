@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace ecs {
+
+// Monotonic arena for data that lives for one tick (sort keys, scratch
+// lists). Allocation is a pointer bump and nothing is freed individually;
+// Reset() drops everything at once. A tick that outgrows the buffer spills
+// to the heap, and the next Reset() enlarges the buffer to cover it, so a
+// steady-state tick does not allocate.
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t capacity = 64 * 1024) : mBuffer(capacity)
+    {
+        mResource.emplace(mBuffer.data(), mBuffer.size(), &mSpill);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // For std::pmr containers; they must not outlive the next Reset().
+    std::pmr::memory_resource* Resource()
+    {
+        return &*mResource;
+    }
+
+    void Reset()
+    {
+        mResource.reset();
+        if (mSpill.bytes > 0) {
+            mBuffer.assign(mBuffer.size() + mSpill.bytes, std::byte{});
+            mSpill.bytes = 0;
+        }
+        mResource.emplace(mBuffer.data(), mBuffer.size(), &mSpill);
+    }
+
+    std::size_t GetCapacity() const
+    {
+        return mBuffer.size();
+    }
+
+private:
+    // Heap fallback that records how much the buffer was short.
+    struct Spill : std::pmr::memory_resource {
+        std::size_t bytes{0};
+
+        void* do_allocate(std::size_t size, std::size_t alignment) override
+        {
+            bytes += size;
+            return std::pmr::new_delete_resource()->allocate(size, alignment);
+        }
+
+        void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    std::vector<std::byte> mBuffer;
+    Spill mSpill{};
+    std::optional<std::pmr::monotonic_buffer_resource> mResource{};
+};
+
+} // namespace ecs
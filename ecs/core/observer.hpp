@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace ecs {
+
+// Receives every entity of one event batch.
+using ObserverCallback = std::function<void(const std::vector<Entity>&)>;
+
+// Component add/remove and signature-match observers. Events are derived
+// from signature transitions, queued, and delivered in batches by Flush().
+class ObserverRegistry {
+public:
+    void OnAdd(ComponentType type, ObserverCallback callback)
+    {
+        mAddObservers[type].push_back(std::move(callback));
+        mObservedAdd.set(type);
+    }
+
+    void OnRemove(ComponentType type, ObserverCallback callback)
+    {
+        mRemoveObservers[type].push_back(std::move(callback));
+        mObservedRemove.set(type);
+    }
+
+    // onEnter/onExit fire when an entity starts/stops matching `required`.
+    // Either callback may be empty.
+    void OnMatch(Signature required, ObserverCallback onEnter, ObserverCallback onExit)
+    {
+        mMatchObservers.push_back({required, std::move(onEnter), std::move(onExit), {}, {}});
+    }
+
+    bool Active() const
+    {
+        return mObservedAdd.any() || mObservedRemove.any() || !mMatchObservers.empty();
+    }
+
+    void SignatureChanged(Entity entity, Signature before, Signature after)
+    {
+        Queue(mAdded, (after & ~before) & mObservedAdd, entity);
+        Queue(mRemoved, (before & ~after) & mObservedRemove, entity);
+        for (auto& observer : mMatchObservers) {
+            bool was = (before & observer.required) == observer.required;
+            bool is = (after & observer.required) == observer.required;
+            if (!was && is && observer.onEnter) {
+                observer.entered.push_back(entity);
+            } else if (was && !is && observer.onExit) {
+                observer.exited.push_back(entity);
+            }
+        }
+    }
+
+    // Delivers queued batches. Events raised by callbacks are kept for the
+    // next flush.
+    void Flush()
+    {
+        for (ComponentType type = 0; type < MAX_COMPONENTS; ++type) {
+            Dispatch(mAdded[type], mAddObservers[type]);
+            Dispatch(mRemoved[type], mRemoveObservers[type]);
+        }
+        for (std::size_t i = 0; i < mMatchObservers.size(); ++i) {
+            DispatchMatch(i, &MatchObserver::entered, &MatchObserver::onEnter);
+            DispatchMatch(i, &MatchObserver::exited, &MatchObserver::onExit);
+        }
+    }
+
+    // Drops pending events (e.g. after loading a world).
+    void Clear()
+    {
+        for (auto& queue : mAdded) {
+            queue.clear();
+        }
+        for (auto& queue : mRemoved) {
+            queue.clear();
+        }
+        for (auto& observer : mMatchObservers) {
+            observer.entered.clear();
+            observer.exited.clear();
+        }
+    }
+
+private:
+    struct MatchObserver {
+        Signature required;
+        ObserverCallback onEnter;
+        ObserverCallback onExit;
+        std::vector<Entity> entered;
+        std::vector<Entity> exited;
+    };
+
+    using Queues = std::array<std::vector<Entity>, MAX_COMPONENTS>;
+
+    static void Queue(Queues& queues, Signature changed, Entity entity)
+    {
+        for (std::uint64_t bits = changed.to_ullong(); bits != 0; bits &= bits - 1) {
+            queues[LowestSetBit(bits)].push_back(entity);
+        }
+    }
+
+    void Dispatch(std::vector<Entity>& queue, std::vector<ObserverCallback>& callbacks)
+    {
+        if (queue.empty()) {
+            return;
+        }
+        mBatch.swap(queue);
+        // By index and copied: a callback may register observers and grow
+        // the vector. Those registered now see the next batch only.
+        const std::size_t count = callbacks.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            ObserverCallback call = callbacks[i];
+            call(mBatch);
+        }
+        mBatch.clear();
+    }
+
+    void DispatchMatch(std::size_t index, std::vector<Entity> MatchObserver::*queue,
+        ObserverCallback MatchObserver::*callback)
+    {
+        if ((mMatchObservers[index].*queue).empty()) {
+            return;
+        }
+        mBatch.swap(mMatchObservers[index].*queue);
+        // Copied: the callback may register observers and grow the vector.
+        ObserverCallback call = mMatchObservers[index].*callback;
+        call(mBatch);
+        mBatch.clear();
+    }
+
+    std::array<std::vector<ObserverCallback>, MAX_COMPONENTS> mAddObservers{};
+    std::array<std::vector<ObserverCallback>, MAX_COMPONENTS> mRemoveObservers{};
+    Signature mObservedAdd{};
+    Signature mObservedRemove{};
+    Queues mAdded{};
+    Queues mRemoved{};
+    std::vector<MatchObserver> mMatchObservers{};
+    std::vector<Entity> mBatch{};
+};
+
+} // namespace ecs
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace ecs {
+
+// World snapshot format: "RTWS", version, then sections aligned on 8 bytes
+// so dense ranges can be copied straight out of a mapped file.
+inline constexpr std::uint32_t WORLD_MAGIC = 0x53575452; // "RTWS"
+inline constexpr std::uint32_t WORLD_FORMAT_VERSION = 4;
+inline constexpr std::size_t WORLD_ALIGNMENT = 8;
+
+// Appends raw bytes in host layout to a growable buffer.
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<std::uint8_t>& out) : mOut(out) {}
+
+    void Write(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        mOut.insert(mOut.end(), bytes, bytes + size);
+    }
+
+    template <typename T>
+    void WritePod(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "POD required");
+        Write(&value, sizeof(T));
+    }
+
+    void Align()
+    {
+        mOut.resize((mOut.size() + WORLD_ALIGNMENT - 1) / WORLD_ALIGNMENT * WORLD_ALIGNMENT, 0);
+    }
+
+private:
+    std::vector<std::uint8_t>& mOut;
+};
+
+// Reads back what BinaryWriter produced; any overrun latches Failed().
+class BinaryReader {
+public:
+    BinaryReader(const std::uint8_t* data, std::size_t size) : mData(data), mSize(size) {}
+
+    // Returns a pointer into the source buffer and advances, or nullptr.
+    const std::uint8_t* Take(std::size_t size)
+    {
+        if (mFailed || size > mSize - mOffset) {
+            mFailed = true;
+            return nullptr;
+        }
+        const std::uint8_t* ptr = mData + mOffset;
+        mOffset += size;
+        return ptr;
+    }
+
+    template <typename T>
+    bool ReadPod(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "POD required");
+        const std::uint8_t* ptr = Take(sizeof(T));
+        if (ptr) {
+            std::memcpy(&value, ptr, sizeof(T));
+        }
+        return ptr != nullptr;
+    }
+
+    void Align()
+    {
+        std::size_t aligned = (mOffset + WORLD_ALIGNMENT - 1) / WORLD_ALIGNMENT * WORLD_ALIGNMENT;
+        Take(aligned - mOffset);
+    }
+
+    bool Failed() const { return mFailed; }
+
+private:
+    const std::uint8_t* mData;
+    std::size_t mSize;
+    std::size_t mOffset{};
+    bool mFailed{false};
+};
+
+} // namespace ecs
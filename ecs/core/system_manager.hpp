@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
 #include <typeindex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "serialization.hpp"
 #include "system.hpp"
 
 namespace ecs {
@@ -18,10 +21,13 @@ public:
     std::shared_ptr<T> RegisterSystem(Args&&... args)
     {
         std::type_index typeName(typeid(T));
-        assert(mSystems.find(typeName) == mSystems.end() && "System registered twice");
+        assert(mSystemIndices.find(typeName) == mSystemIndices.end() && "System registered twice");
 
         auto system = std::make_shared<T>(std::forward<Args>(args)...);
-        mSystems[typeName] = system;
+        mSystemIndices[typeName] = mSystemOrder.size();
+        mSystemOrder.push_back(system);
+        mSignatures.emplace_back();
+        mPositions.emplace_back(MAX_ENTITIES, NOT_MEMBER);
         return system;
     }
 
@@ -29,48 +35,119 @@ public:
     void SetSignature(Signature signature)
     {
         std::type_index typeName(typeid(T));
-        auto it = mSystems.find(typeName);
-        assert(it != mSystems.end() && "System not registered");
+        auto it = mSystemIndices.find(typeName);
+        assert(it != mSystemIndices.end() && "System not registered");
 
-        mSignatures[typeName] = signature;
-        it->second->signature = signature;
+        mSignatures[it->second] = signature;
+        mSystemOrder[it->second]->signature = signature;
     }
 
-    void EntityDestroyed(Entity entity)
+    // An entity can only belong to systems whose signature it matches.
+    void EntityDestroyed(Entity entity, Signature entitySignature)
     {
-        for (auto& [_, system] : mSystems) {
-            RemoveEntity(system->entities, entity);
+        for (std::size_t i = 0; i < mSystemOrder.size(); ++i) {
+            if ((entitySignature & mSignatures[i]) == mSignatures[i]) {
+                RemoveEntity(i, entity);
+            }
         }
     }
 
     void EntitySignatureChanged(Entity entity, Signature entitySignature)
     {
-        for (auto& [type, system] : mSystems) {
-            const Signature& required = mSignatures[type];
-            bool matches = (entitySignature & required) == required;
-            if (matches) {
-                if (!Contains(system->entities, entity)) {
-                    system->entities.push_back(entity);
-                }
+        for (std::size_t i = 0; i < mSystemOrder.size(); ++i) {
+            if ((entitySignature & mSignatures[i]) == mSignatures[i]) {
+                AddEntity(i, entity);
             } else {
-                RemoveEntity(system->entities, entity);
+                RemoveEntity(i, entity);
+            }
+        }
+    }
+
+    // Membership lists in registration order, so iteration order (and thus
+    // simulation results) survive a save/load.
+    void Save(BinaryWriter& writer) const
+    {
+        writer.WritePod(static_cast<std::uint32_t>(mSystemOrder.size()));
+        for (const auto& system : mSystemOrder) {
+            writer.WritePod(static_cast<std::uint32_t>(system->entities.size()));
+            writer.Write(system->entities.data(), system->entities.size() * sizeof(Entity));
+        }
+    }
+
+    bool Parse(BinaryReader& reader, std::vector<std::vector<Entity>>& lists) const
+    {
+        std::uint32_t count = 0;
+        if (!reader.ReadPod(count) || count != mSystemOrder.size()) {
+            return false;
+        }
+        lists.assign(count, {});
+        for (auto& list : lists) {
+            std::uint32_t size = 0;
+            if (!reader.ReadPod(size) || size > MAX_ENTITIES) {
+                return false;
+            }
+            const std::uint8_t* data = reader.Take(size * sizeof(Entity));
+            if (!data) {
+                return false;
+            }
+            list.resize(size);
+            if (size > 0) {
+                std::memcpy(list.data(), data, size * sizeof(Entity));
+            }
+            for (Entity entity : list) {
+                if (entity >= MAX_ENTITIES) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void Apply(std::vector<std::vector<Entity>>& lists)
+    {
+        for (std::size_t i = 0; i < mSystemOrder.size(); ++i) {
+            mSystemOrder[i]->entities = std::move(lists[i]);
+            std::fill(mPositions[i].begin(), mPositions[i].end(), NOT_MEMBER);
+            const auto& entities = mSystemOrder[i]->entities;
+            for (std::size_t position = 0; position < entities.size(); ++position) {
+                mPositions[i][entities[position]] = static_cast<std::uint32_t>(position);
             }
         }
     }
 
 private:
-    static void RemoveEntity(std::vector<Entity>& entities, Entity entity)
+    static constexpr std::uint32_t NOT_MEMBER = 0xFFFFFFFF;
+
+    void AddEntity(std::size_t system, Entity entity)
     {
-        entities.erase(std::remove(entities.begin(), entities.end(), entity), entities.end());
+        std::uint32_t& position = mPositions[system][entity];
+        if (position == NOT_MEMBER) {
+            auto& entities = mSystemOrder[system]->entities;
+            position = static_cast<std::uint32_t>(entities.size());
+            entities.push_back(entity);
+        }
     }
 
-    static bool Contains(const std::vector<Entity>& entities, Entity entity)
+    // Swap-remove through the position table: O(1) instead of a scan.
+    void RemoveEntity(std::size_t system, Entity entity)
     {
-        return std::find(entities.begin(), entities.end(), entity) != entities.end();
+        std::uint32_t& position = mPositions[system][entity];
+        if (position == NOT_MEMBER) {
+            return;
+        }
+        auto& entities = mSystemOrder[system]->entities;
+        Entity last = entities.back();
+        entities[position] = last;
+        mPositions[system][last] = position;
+        entities.pop_back();
+        position = NOT_MEMBER;
     }
 
-    std::unordered_map<std::type_index, Signature> mSignatures{};
-    std::unordered_map<std::type_index, std::shared_ptr<System>> mSystems{};
+    std::unordered_map<std::type_index, std::size_t> mSystemIndices{};
+    std::vector<std::shared_ptr<System>> mSystemOrder{};
+    std::vector<Signature> mSignatures{};
+    // Per system: index of each entity in its list, or NOT_MEMBER.
+    std::vector<std::vector<std::uint32_t>> mPositions{};
 };
 
 } // namespace ecs
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace ecs {
+
+// Hierarchical timer wheel keyed by simulation tick. Each tick touches one
+// slot of the first level (plus a cascade every 64 ticks), so the cost is
+// proportional to the timers that expire, not to the timers pending.
+// There is no cancellation: owners keep the deadline in their component
+// and ignore expired timers that no longer match it.
+class TimerWheel {
+public:
+    struct Timer {
+        Entity entity;
+        std::uint32_t deadline;
+    };
+
+    std::uint32_t GetNow() const { return mNow; }
+    std::size_t GetPending() const { return mPending; }
+
+    // Drops every timer and restarts the wheel at `now`.
+    void Reset(std::uint32_t now)
+    {
+        for (auto& level : mLevels) {
+            for (auto& slot : level) {
+                slot.clear();
+            }
+        }
+        mDue.clear();
+        mOverflow.clear();
+        mPending = 0;
+        mNow = now;
+    }
+
+    // A deadline not after the current tick fires on the next Advance().
+    void Schedule(Entity entity, std::uint32_t deadline)
+    {
+        ++mPending;
+        Insert({entity, deadline});
+    }
+
+    // Call before scheduling the timers of tick `now`: after a world was
+    // loaded from an earlier tick every timer is dropped, and owners
+    // reschedule from the deadlines stored in their components.
+    void Rewind(std::uint32_t now)
+    {
+        if (now < mNow) {
+            Reset(now > 0 ? now - 1 : 0);
+        }
+    }
+
+    // Moves the wheel to `now` and appends every timer whose deadline is
+    // reached to `expired`, sorted by (deadline, entity), each timer once.
+    // The order inside a slot, and the duplicates left by reschedules,
+    // depend on the wheel's history; a wheel rebuilt from a loaded world
+    // then fires exactly like the one that kept running.
+    void Advance(std::uint32_t now, std::vector<Timer>& expired)
+    {
+        std::size_t first = expired.size();
+        Collect(mDue, expired);
+        while (mNow < now) {
+            ++mNow;
+            // Highest first: a cascade only refills lower levels.
+            if ((mNow & ((std::uint32_t{1} << (SLOT_BITS * LEVELS)) - 1)) == 0) {
+                Cascade(mOverflow);
+            }
+            for (std::size_t level = LEVELS - 1; level > 0; --level) {
+                if ((mNow & ((std::uint32_t{1} << (SLOT_BITS * level)) - 1)) == 0) {
+                    Cascade(mLevels[level][(mNow >> (SLOT_BITS * level)) & SLOT_MASK]);
+                }
+            }
+            Collect(mLevels[0][mNow & SLOT_MASK], expired);
+            Collect(mDue, expired);
+        }
+        std::sort(expired.begin() + static_cast<std::ptrdiff_t>(first), expired.end(),
+            [](const Timer& a, const Timer& b) {
+                return a.deadline != b.deadline ? a.deadline < b.deadline : a.entity < b.entity;
+            });
+        expired.erase(std::unique(expired.begin() + static_cast<std::ptrdiff_t>(first), expired.end(),
+            [](const Timer& a, const Timer& b) { return a.deadline == b.deadline && a.entity == b.entity; }),
+            expired.end());
+    }
+
+private:
+    static constexpr std::size_t LEVELS = 4;
+    static constexpr std::uint32_t SLOT_BITS = 6;
+    static constexpr std::uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr std::uint32_t SLOT_MASK = SLOTS - 1;
+
+    // Lowest level whose slot is reached before the deadline's higher bits
+    // change; timers beyond the last level wait in the overflow list.
+    void Insert(Timer timer)
+    {
+        if (timer.deadline <= mNow) {
+            mDue.push_back(timer);
+            return;
+        }
+        std::uint32_t differing = timer.deadline ^ mNow;
+        for (std::size_t level = 0; level < LEVELS; ++level) {
+            std::uint32_t shift = SLOT_BITS * static_cast<std::uint32_t>(level + 1);
+            if ((differing >> shift) == 0) {
+                mLevels[level][(timer.deadline >> (SLOT_BITS * level)) & SLOT_MASK].push_back(timer);
+                return;
+            }
+        }
+        mOverflow.push_back(timer);
+    }
+
+    // Copied rather than swapped: each slot keeps its capacity, so a wheel
+    // in steady state stops allocating.
+    void Cascade(std::vector<Timer>& slot)
+    {
+        mCascade.assign(slot.begin(), slot.end());
+        slot.clear();
+        for (const Timer& timer : mCascade) {
+            Insert(timer);
+        }
+        mCascade.clear();
+    }
+
+    void Collect(std::vector<Timer>& slot, std::vector<Timer>& expired)
+    {
+        mPending -= slot.size();
+        expired.insert(expired.end(), slot.begin(), slot.end());
+        slot.clear();
+    }
+
+    std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> mLevels{};
+    std::vector<Timer> mDue{};
+    std::vector<Timer> mOverflow{};
+    std::vector<Timer> mCascade{};
+    std::uint32_t mNow{0};
+    std::size_t mPending{0};
+};
+
+} // namespace ecs
@@ -3,6 +3,10 @@
 #include <bitset>
 #include <cstdint>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace ecs {
 
 using Entity = std::uint32_t;
@@ -13,5 +17,18 @@ inline constexpr ComponentType MAX_COMPONENTS = 64;
 
 using Signature = std::bitset<MAX_COMPONENTS>;
 
+// Index of the lowest set bit of a non-zero word, used to walk the bits of
+// Signature::to_ullong().
+inline unsigned LowestSetBit(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
 } // namespace ecs
 
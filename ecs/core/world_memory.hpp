@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ecs {
+
+// Where a world's component storage lives. The default keeps it on the
+// regular heap.
+struct MemoryPolicy {
+    static constexpr int NO_NODE = -1;
+    // The NUMA node of the thread calling Coordinator::Init().
+    static constexpr int CURRENT_NODE = -2;
+
+    // Back storage with 2 MiB transparent huge pages (madvise), which cuts
+    // TLB misses on the large arrays every tick walks.
+    bool hugePages{false};
+    // Bind storage to this NUMA node (mbind); NO_NODE leaves placement to
+    // the kernel's first-touch policy.
+    int numaNode{NO_NODE};
+
+    bool IsDefault() const { return !hugePages && numaNode == NO_NODE; }
+};
+
+// What the kernel actually granted; both are best effort.
+struct MemoryStatus {
+    bool hugePages{false};
+    int numaNode{MemoryPolicy::NO_NODE};
+};
+
+// One region of address space per world, reserved up front and handed out
+// by bumping a pointer. Only the pages storage touches are committed.
+// Memory is never returned before the heap is destroyed, which suits
+// component arrays: they are created once, at registration.
+class WorldHeap {
+public:
+    static constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{2} << 20;
+    static constexpr std::size_t DEFAULT_RESERVE = std::size_t{256} << 20;
+
+    explicit WorldHeap(const MemoryPolicy& policy, std::size_t reserve = DEFAULT_RESERVE)
+    {
+#if defined(__linux__)
+        std::size_t size = (reserve + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        // Over-reserve to align the region on a huge page boundary.
+        void* raw = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (raw == MAP_FAILED) {
+            return;
+        }
+        auto begin = reinterpret_cast<std::uintptr_t>(raw);
+        auto aligned = (begin + HUGE_PAGE_SIZE - 1) & ~(std::uintptr_t{HUGE_PAGE_SIZE} - 1);
+        if (aligned > begin) {
+            munmap(raw, aligned - begin);
+        }
+        std::size_t tail = HUGE_PAGE_SIZE - (aligned - begin);
+        if (tail > 0) {
+            munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+        mBase = reinterpret_cast<std::uint8_t*>(aligned);
+        mSize = size;
+
+        // Both must precede the first touch, which is when pages are placed.
+        if (policy.hugePages) {
+            mStatus.hugePages = madvise(mBase, mSize, MADV_HUGEPAGE) == 0;
+        }
+        int node = policy.numaNode == MemoryPolicy::CURRENT_NODE ? CurrentNode() : policy.numaNode;
+        if (node >= 0 && Bind(node)) {
+            mStatus.numaNode = node;
+        }
+#else
+        (void)policy;
+        (void)reserve;
+#endif
+    }
+
+    ~WorldHeap()
+    {
+#if defined(__linux__)
+        if (mBase) {
+            munmap(mBase, mSize);
+        }
+#endif
+    }
+
+    WorldHeap(const WorldHeap&) = delete;
+    WorldHeap& operator=(const WorldHeap&) = delete;
+
+    // nullptr once the region is exhausted (or could not be reserved);
+    // callers fall back to the regular heap.
+    void* Allocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t offset = (mUsed + alignment - 1) & ~(alignment - 1);
+        if (!mBase || offset + size > mSize) {
+            return nullptr;
+        }
+        mUsed = offset + size;
+        return mBase + offset;
+    }
+
+    MemoryStatus GetStatus() const { return mStatus; }
+    std::size_t GetUsed() const { return mUsed; }
+
+private:
+#if defined(__linux__)
+    static int CurrentNode()
+    {
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+            return MemoryPolicy::NO_NODE;
+        }
+        return static_cast<int>(node);
+    }
+
+    // Raw syscall: no libnuma dependency. MPOL_BIND keeps every page of the
+    // region on `node`, even when touched from another socket.
+    bool Bind(int node)
+    {
+        constexpr int MPOL_BIND_MODE = 2;
+        constexpr unsigned long MASK_BITS = 1024;
+        if (node >= static_cast<int>(MASK_BITS)) {
+            return false;
+        }
+        unsigned long mask[MASK_BITS / (8 * sizeof(unsigned long))] = {};
+        mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+        return syscall(SYS_mbind, mBase, mSize, MPOL_BIND_MODE, mask, MASK_BITS + 1, 0) == 0;
+    }
+#endif
+
+    std::uint8_t* mBase{nullptr};
+    std::size_t mSize{0};
+    std::size_t mUsed{0};
+    MemoryStatus mStatus{};
+};
+
+} // namespace ecs
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "components.hpp"
+#include "ecs.hpp"
+
+namespace ecs {
+
+// Position d'un projectile balistique au tick `tick`, `origin` étant son
+// Transform.
+inline Transform BallisticPosition(const Transform& origin, const Ballistic& ballistic, std::uint32_t tick) {
+    float elapsed = static_cast<float>(tick - ballistic.spawnTick);
+    return Transform{origin.x + ballistic.stepX * elapsed, origin.y + ballistic.stepY * elapsed, origin.rotation};
+}
+
+// Position de l'entité au tick courant : le Transform tel quel, sauf pour
+// un projectile balistique. Pour les systèmes qui lisent la position de
+// n'importe quelle entité (collision, réplication, historique).
+inline Transform CurrentTransform(Entity entity) {
+    const auto& transform = gCoordinator.GetComponent<Transform>(entity);
+    if (!gCoordinator.HasComponent<Ballistic>(entity)) {
+        return transform;
+    }
+    return BallisticPosition(transform, gCoordinator.GetComponent<Ballistic>(entity), gCoordinator.GetTick());
+}
+
+// Premier tick où le projectile est hors de `boundary`, Ballistic::NEVER
+// s'il n'en sort pas (immobile, ou au-delà de 2^24 ticks). L'estimation
+// par axe est ajustée sur BallisticPosition même, pour que la sortie
+// tombe sur le tick où les autres systèmes le voient dehors.
+inline std::uint32_t BallisticExitTick(const Transform& origin, const Ballistic& ballistic, const Boundary& boundary) {
+    constexpr float MAX_ELAPSED = static_cast<float>(1u << 24);
+    auto outside = [&](std::uint32_t elapsed) {
+        Transform position = BallisticPosition(origin, ballistic, ballistic.spawnTick + elapsed);
+        return position.x < boundary.minX || position.x > boundary.maxX ||
+            position.y < boundary.minY || position.y > boundary.maxY;
+    };
+
+    float limit = MAX_ELAPSED;
+    if (ballistic.stepX > 0.f) limit = std::min(limit, (boundary.maxX - origin.x) / ballistic.stepX);
+    if (ballistic.stepX < 0.f) limit = std::min(limit, (boundary.minX - origin.x) / ballistic.stepX);
+    if (ballistic.stepY > 0.f) limit = std::min(limit, (boundary.maxY - origin.y) / ballistic.stepY);
+    if (ballistic.stepY < 0.f) limit = std::min(limit, (boundary.minY - origin.y) / ballistic.stepY);
+    if (limit >= MAX_ELAPSED) {
+        return Ballistic::NEVER;
+    }
+
+    auto elapsed = static_cast<std::uint32_t>(std::max(0.f, std::floor(limit)));
+    while (elapsed > 0 && outside(elapsed - 1)) {
+        --elapsed;
+    }
+    while (!outside(elapsed)) {
+        ++elapsed;
+    }
+    return ballistic.spawnTick + elapsed;
+}
+
+} // namespace ecs
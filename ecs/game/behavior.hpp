@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "components.hpp"
+
+namespace ecs {
+
+inline constexpr std::size_t AI_STATE_COUNT = 5;
+
+// Mouvement appliqué à la vélocité tant que l'IA reste dans un état.
+enum class Motion : std::uint8_t {
+    Stop,  // vélocité nulle
+    Drift, // vélocité constante (vx, vy)
+    Seek,  // vers la cible à `speed`
+    Flee   // à l'opposé de la cible à `speed`
+};
+
+struct StateAction {
+    Motion motion{Motion::Stop};
+    float speed{0.f};
+    // Drift ; pour Seek/Flee sans cible, si `driftWithoutTarget` (sinon la
+    // vélocité est laissée telle quelle).
+    float vx{0.f};
+    float vy{0.f};
+    bool driftWithoutTarget{false};
+};
+
+// Un type d'ennemi : une action par état de AIController, plus les
+// paramètres de décision recopiés dans le composant à la création.
+struct Behavior {
+    std::string name;
+    std::array<StateAction, AI_STATE_COUNT> actions{};
+    float detectionRange{200.f};
+    float attackRange{50.f};
+    float fleeHealthThreshold{0.3f};
+    float decisionCooldown{1.f};
+};
+
+// Comportement historique (ancien switch de AISystem), toujours à
+// l'indice 0 : un AIController par défaut l'utilise.
+inline Behavior DefaultBehavior() {
+    Behavior behavior;
+    behavior.name = "default";
+    auto& actions = behavior.actions;
+    actions[static_cast<std::size_t>(AIController::State::Idle)] = {Motion::Stop};
+    actions[static_cast<std::size_t>(AIController::State::Patrolling)] = {Motion::Drift, 0.f, 50.f, 0.f};
+    actions[static_cast<std::size_t>(AIController::State::Chasing)] = {Motion::Seek, 150.f};
+    actions[static_cast<std::size_t>(AIController::State::Fleeing)] = {Motion::Flee, 200.f, -100.f, 0.f, true};
+    actions[static_cast<std::size_t>(AIController::State::Attacking)] = {Motion::Stop};
+    return behavior;
+}
+
+// Table des comportements, indexée par AIController::behavior. Chargée
+// depuis un fichier (voir behavior_io.hpp) : un nouveau type d'ennemi ne
+// demande pas de recompiler le serveur.
+class BehaviorLibrary {
+public:
+    BehaviorLibrary() : mBehaviors{DefaultBehavior()} {}
+
+    // Remplace un comportement de même nom, sinon l'ajoute. Renvoie son
+    // indice.
+    std::uint8_t Add(const Behavior& behavior) {
+        for (std::size_t i = 0; i < mBehaviors.size(); ++i) {
+            if (mBehaviors[i].name == behavior.name) {
+                mBehaviors[i] = behavior;
+                return static_cast<std::uint8_t>(i);
+            }
+        }
+        assert(mBehaviors.size() < 256 && "Too many behaviors");
+        mBehaviors.push_back(behavior);
+        return static_cast<std::uint8_t>(mBehaviors.size() - 1);
+    }
+
+    // Indice du comportement `name`, ou Size() s'il n'existe pas.
+    std::size_t Find(const std::string& name) const {
+        for (std::size_t i = 0; i < mBehaviors.size(); ++i) {
+            if (mBehaviors[i].name == name) {
+                return i;
+            }
+        }
+        return mBehaviors.size();
+    }
+
+    // Un indice inconnu (table rechargée plus courte) retombe sur le
+    // comportement par défaut.
+    const Behavior& Get(std::uint8_t index) const {
+        return index < mBehaviors.size() ? mBehaviors[index] : mBehaviors[0];
+    }
+
+    std::size_t Size() const { return mBehaviors.size(); }
+
+    // AIController prêt à l'emploi pour un ennemi de ce type.
+    AIController MakeController(std::uint8_t index) const {
+        const Behavior& behavior = Get(index);
+        AIController ai;
+        ai.behavior = index < mBehaviors.size() ? index : 0;
+        ai.detectionRange = behavior.detectionRange;
+        ai.attackRange = behavior.attackRange;
+        ai.fleeHealthThreshold = behavior.fleeHealthThreshold;
+        ai.decisionCooldown = behavior.decisionCooldown;
+        return ai;
+    }
+
+private:
+    std::vector<Behavior> mBehaviors;
+};
+
+} // namespace ecs
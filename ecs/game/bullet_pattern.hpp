@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "components.hpp"
+
+namespace ecs {
+
+// Salve émise par un Spawner à chaque cooldown, décrite par des paramètres
+// plutôt que par autant de spawners que de projectiles. La direction de
+// référence est la vélocité du spawner (spawnVelocityX/Y) ; le projectile
+// de rang i part tourné de
+//   rotationRate * t + (-spread / 2 + i * spread / (count - 1))
+// (t = rang de la salve * cooldown), à la vitesse |spawnVelocity| +
+// i * speedStep. Un éventail d'au moins 2π fait un anneau régulier.
+struct BulletPattern {
+    std::string name;
+    int count{1};
+    float spread{0.f};       // radians, éventail total
+    float rotationRate{0.f}; // radians par seconde de tir : spirales
+    float speedStep{0.f};    // rampe de vitesse d'un rang au suivant
+    bool aimed{false};       // salve centrée sur la cible de l'IA du spawner
+};
+
+// Vélocité du projectile `rank` de la salve `volley`. `aim` (radians) est
+// l'écart entre la direction de référence et la cible, 0 sinon. Sans
+// rotation ni rampe la vélocité du spawner est reprise à l'identique.
+inline Velocity PatternVelocity(const BulletPattern& pattern, const Spawner& spawner, int volley, int rank,
+    float aim = 0.f) {
+    constexpr float TWO_PI = 6.28318530718f;
+    float angle = aim + pattern.rotationRate * static_cast<float>(volley) * spawner.spawnCooldown;
+    if (pattern.count > 1) {
+        bool ring = pattern.spread >= TWO_PI - 1e-4f;
+        float step = ring ? TWO_PI / static_cast<float>(pattern.count)
+                          : pattern.spread / static_cast<float>(pattern.count - 1);
+        angle += (ring ? 0.f : -pattern.spread / 2.f) + step * static_cast<float>(rank);
+    }
+    float scale = 1.f;
+    float speed = std::sqrt(spawner.spawnVelocityX * spawner.spawnVelocityX +
+        spawner.spawnVelocityY * spawner.spawnVelocityY);
+    if (speed > 0.f && pattern.speedStep != 0.f) {
+        scale = (speed + pattern.speedStep * static_cast<float>(rank)) / speed;
+    }
+    if (angle == 0.f && scale == 1.f) {
+        return Velocity{spawner.spawnVelocityX, spawner.spawnVelocityY};
+    }
+    float c = std::cos(angle) * scale;
+    float s = std::sin(angle) * scale;
+    return Velocity{spawner.spawnVelocityX * c - spawner.spawnVelocityY * s,
+        spawner.spawnVelocityX * s + spawner.spawnVelocityY * c};
+}
+
+// Patterns indexés par Spawner::pattern ; l'indice 0 est le tir simple
+// historique (un projectile à la vélocité du spawner).
+class PatternLibrary {
+public:
+    PatternLibrary() : mPatterns{BulletPattern{"single"}} {}
+
+    // Remplace un pattern de même nom, sinon l'ajoute. Renvoie son indice.
+    std::uint8_t Add(const BulletPattern& pattern) {
+        assert(pattern.count >= 1 && "A volley needs at least one bullet");
+        for (std::size_t i = 0; i < mPatterns.size(); ++i) {
+            if (mPatterns[i].name == pattern.name) {
+                mPatterns[i] = pattern;
+                return static_cast<std::uint8_t>(i);
+            }
+        }
+        assert(mPatterns.size() < 256 && "Too many patterns");
+        mPatterns.push_back(pattern);
+        return static_cast<std::uint8_t>(mPatterns.size() - 1);
+    }
+
+    // Un indice inconnu retombe sur le tir simple.
+    const BulletPattern& Get(std::uint8_t index) const {
+        return index < mPatterns.size() ? mPatterns[index] : mPatterns[0];
+    }
+
+    std::size_t Size() const { return mPatterns.size(); }
+
+private:
+    std::vector<BulletPattern> mPatterns;
+};
+
+} // namespace ecs
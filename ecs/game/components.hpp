@@ -1,10 +1,13 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
 #include "types.hpp"
 
 namespace ecs {
 
+// Les composants sont sauvegardés bruts (SaveWorld) : le bourrage est
+// déclaré en champs `reserved` mis à zéro, sans quoi deux mondes
+// identiques (partie et replay) différeraient par des octets indéfinis.
+
 struct Transform {
     float x{};
     float y{};
@@ -27,17 +30,25 @@ struct Collider {
     float width{20.f};
     float height{20.f};
     bool isTrigger{false};
+    std::uint8_t reserved[3]{};
 };
 
 struct Health {
     int current{100};
     int max{100};
     bool invincible{false};
+    std::uint8_t reserved[3]{};
     float invincibilityTimer{0.f};
+    // Tick de fin planifié par HealthSystem (0 = à planifier) : le remettre
+    // à 0 en même temps que invincibilityTimer.
+    std::uint32_t invincibleUntil{0};
 };
 
+// timeLeft compte à partir de l'écriture du composant ; expireTick est le
+// tick d'expiration planifié par LifetimeSystem (0 = à planifier).
 struct Lifetime {
     float timeLeft{5.f};
+    std::uint32_t expireTick{0};
 };
 
 struct Score {
@@ -51,6 +62,7 @@ struct Boundary {
     float maxY{600.f};
     bool wrap{false}; 
     bool destroy{true};
+    std::uint8_t reserved[2]{};
 };
 
 // PlayerInput: Stocke la direction d'input (1-9, numpad style)
@@ -60,6 +72,7 @@ struct Boundary {
 struct PlayerInput {
     int direction{5};
     bool firePressed{false};
+    std::uint8_t reserved[3]{};
 };
 
 struct Team {
@@ -81,12 +94,20 @@ struct AIController {
     
     State currentState{State::Idle};
     Entity target{MAX_ENTITIES};
-    float decisionTimer{0.f};
+    float decisionTimer{0.f}; // Temps déjà écoulé avant la première décision
     float decisionCooldown{1.0f}; // Temps entre les décisions
+    std::uint32_t nextDecisionTick{0}; // Planifié par AISystem (0 = à planifier)
     
     float detectionRange{200.f};
     float attackRange{50.f};
     float fleeHealthThreshold{0.3f}; // Fuit si santé < 30%
+    std::uint8_t behavior{0}; // Indice dans la BehaviorLibrary de AISystem
+    std::uint8_t reserved[3]{};
+};
+
+// NetworkId: identifiant de l'entité côté serveur (réplication client)
+struct NetworkId {
+    Entity serverId{MAX_ENTITIES};
 };
 
 struct Spawner {
@@ -98,7 +119,8 @@ struct Spawner {
     
     SpawnType typeToSpawn{SpawnType::Projectile};
     float spawnCooldown{1.0f};
-    float spawnTimer{0.f};
+    float spawnTimer{0.f}; // Temps déjà écoulé avant le premier spawn
+    std::uint32_t nextSpawnTick{0}; // Planifié par SpawnerSystem (0 = à planifier)
     int maxSpawns{-1};
     int spawnCount{0};
     
@@ -106,6 +128,22 @@ struct Spawner {
     float spawnOffsetY{0.f};
     float spawnVelocityX{0.f};
     float spawnVelocityY{100.f};
+    std::uint8_t pattern{0}; // Indice dans la PatternLibrary de SpawnerSystem (0 = tir simple)
+    std::uint8_t reserved[3]{};
+};
+
+// Ballistic: projectile à vitesse constante dont la position est calculée
+// au lieu d'être intégrée. Le Transform garde l'origine du tir ; au tick t
+// la position vaut origine + step * (t - spawnTick). MovementSystem ne le
+// déplace pas et le Boundary n'est pas appliqué (wrap, clamp) : seule la
+// sortie d'un Boundary destroy est planifiée, par BallisticSystem.
+struct Ballistic {
+    static constexpr std::uint32_t NEVER = 0xffffffffu;
+
+    float stepX{0.f}; // déplacement par tick (vélocité * dt)
+    float stepY{0.f};
+    std::uint32_t spawnTick{0};
+    std::uint32_t exitTick{0}; // Planifié par BallisticSystem (0 = à planifier)
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace ecs {
+
+// Émis par la détection de collision, appliqué par DamageSystem.
+// destroySource : le projectile (collider non trigger) disparaît si le coup
+// passe.
+struct DamageEvent {
+    Entity target{MAX_ENTITIES};
+    Entity source{MAX_ENTITIES};
+    int amount{0};
+    bool destroySource{false};
+};
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ecs {
+
+namespace detail {
+
+// Restreint [enter, leave] aux u où |start + u * move| < half.
+inline bool Slab(float start, float move, float half, float& enter, float& leave) {
+    if (move == 0.f) {
+        return std::fabs(start) < half;
+    }
+    float t1 = (-half - start) / move;
+    float t2 = (half - start) / move;
+    enter = std::max(enter, std::min(t1, t2));
+    leave = std::min(leave, std::max(t1, t2));
+    return true;
+}
+
+// Le segment start + u * move (u dans [0, 1]) passe-t-il strictement à
+// l'intérieur de |x| < halfWidth, |y| < halfHeight ? (méthode des slabs)
+inline bool SegmentInBox(float startX, float startY, float moveX, float moveY, float halfWidth, float halfHeight) {
+    float enter = -std::numeric_limits<float>::infinity();
+    float leave = std::numeric_limits<float>::infinity();
+    if (!Slab(startX, moveX, halfWidth, enter, leave) || !Slab(startY, moveY, halfHeight, enter, leave)) {
+        return false;
+    }
+    return enter < leave && enter < 1.f && leave > 0.f;
+}
+
+inline float SegmentPointDistanceSquared(float startX, float startY, float moveX, float moveY,
+                                         float pointX, float pointY) {
+    float length = moveX * moveX + moveY * moveY;
+    float u = 0.f;
+    if (length > 0.f) {
+        u = std::clamp(((pointX - startX) * moveX + (pointY - startY) * moveY) / length, 0.f, 1.f);
+    }
+    float dx = startX + u * moveX - pointX;
+    float dy = startY + u * moveY - pointY;
+    return dx * dx + dy * dy;
+}
+
+} // namespace detail
+
+// Test commun à la collision et à la compensation de latence. Deux formes
+// (cercle : demi-côtés nuls ; boîte AABB : rayon nul) se touchent si le
+// centre de la seconde, vu depuis la première, entre dans leur somme de
+// Minkowski : un rectangle arrondi de demi-côtés `halfWidth`, `halfHeight`
+// (sommes des demi-côtés) et de rayon `radius` (somme des rayons), centré
+// à l'origine. Le centre suit start + u * move, u dans [0, 1] ; move nul
+// pour un test statique.
+inline bool SweptRoundedBoxHit(float startX, float startY, float moveX, float moveY,
+                               float halfWidth, float halfHeight, float radius) {
+    if (halfWidth == 0.f && halfHeight == 0.f) {
+        // Deux cercles
+        return detail::SegmentPointDistanceSquared(startX, startY, moveX, moveY, 0.f, 0.f) < radius * radius;
+    }
+    if (detail::SegmentInBox(startX, startY, moveX, moveY, halfWidth + radius, halfHeight) ||
+        detail::SegmentInBox(startX, startY, moveX, moveY, halfWidth, halfHeight + radius)) {
+        return true;
+    }
+    if (radius <= 0.f) {
+        return false;
+    }
+    // Coins arrondis
+    for (float cornerX : {-halfWidth, halfWidth}) {
+        for (float cornerY : {-halfHeight, halfHeight}) {
+            if (detail::SegmentPointDistanceSquared(startX, startY, moveX, moveY, cornerX, cornerY) < radius * radius) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace ecs
@@ -2,18 +2,48 @@
 
 #include "ecs.hpp"
 #include "components.hpp"
-#include <SFML/Graphics.hpp>
+#include "events.hpp"
+#include "behavior.hpp"
+#include "bullet_pattern.hpp"
+#include "ballistic.hpp"
+#include "overlap.hpp"
 #include <cmath>
 #include <algorithm>
+#include <bitset>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 
 namespace ecs {
 
+// Durée convertie en ticks de simulation pour la roue de timers : au moins
+// un tick, au plus 2^30 (~200 jours à 60 Hz). La marge absorbe l'arrondi
+// flottant de seconds / dt.
+inline std::uint32_t TicksFor(float seconds, float dt) {
+    constexpr float MAX_TICKS = static_cast<float>(1u << 30);
+    if (dt <= 0.f || seconds <= dt) {
+        return 1;
+    }
+    return static_cast<std::uint32_t>(std::min(std::ceil(seconds / dt - 1e-3f), MAX_TICKS));
+}
+
 // === Movement System ===
 class MovementSystem : public System {
 public:
     void Update(float dt) {
-        for (Entity entity : entities) {
-            auto& transform = gCoordinator.GetComponent<Transform>(entity);
+        UpdateEntities(entities, dt);
+    }
+
+    // Applique le mouvement à un sous-ensemble (ex: prédiction client).
+    // Les projectiles balistiques sont sautés : leur position se calcule.
+    void UpdateEntities(const std::vector<Entity>& subset, float dt) {
+        ComponentType ballistic = gCoordinator.GetComponentType<Ballistic>();
+        for (Entity entity : gCoordinator.Enabled(subset)) {
+            if (gCoordinator.GetSignature(entity).test(ballistic)) {
+                continue;
+            }
+            auto& transform = gCoordinator.WriteComponent<Transform>(entity);
             const auto& velocity = gCoordinator.GetComponent<Velocity>(entity);
             
             transform.x += velocity.vx * dt;
@@ -26,9 +56,13 @@ public:
 class InputSystem : public System {
 public:
     void Update(float speed = 200.f) {
-        for (Entity entity : entities) {
+        UpdateEntities(entities, speed);
+    }
+
+    void UpdateEntities(const std::vector<Entity>& subset, float speed = 200.f) {
+        for (Entity entity : gCoordinator.Enabled(subset)) {
             const auto& input = gCoordinator.GetComponent<PlayerInput>(entity);
-            auto& velocity = gCoordinator.GetComponent<Velocity>(entity);
+            auto& velocity = gCoordinator.WriteComponent<Velocity>(entity);
             
             // Convertit direction (1-9) en vecteur de vélocité
             velocity.vx = 0.f;
@@ -57,28 +91,91 @@ public:
 };
 
 // === AI System ===
+// Les décisions sont planifiées dans une roue de timers : seules les IA
+// dont la décision tombe ce tick sont réévaluées. Le mouvement de chaque
+// état vient de la BehaviorLibrary (données, pas de code).
 class AISystem : public System {
 public:
+    void SetBehaviors(BehaviorLibrary behaviors) {
+        mBehaviors = std::move(behaviors);
+    }
+
+    const BehaviorLibrary& GetBehaviors() const {
+        return mBehaviors;
+    }
+
     void Update(float dt) {
+        std::uint32_t now = gCoordinator.GetTick();
+        std::uint32_t since = mCheckedTick;
+
+        // Nouvelles IA (ou monde rechargé) : planifier leur première décision
+        mWheel.Rewind(now);
+        gCoordinator.ForEachChanged<AIController>(since, [&](Entity entity, const AIController& ai) {
+            std::uint32_t deadline = ai.nextDecisionTick;
+            if (deadline == 0) {
+                deadline = now + TicksFor(ai.decisionCooldown - ai.decisionTimer, dt);
+            }
+            Schedule(entity, deadline);
+        });
+
+        // Prendre des décisions périodiquement
+        mExpired.clear();
+        mWheel.Advance(now, mExpired);
+        for (const auto& timer : mExpired) {
+            if (!gCoordinator.HasComponent<AIController>(timer.entity)) {
+                continue;
+            }
+            auto& ai = gCoordinator.GetComponentUntracked<AIController>(timer.entity);
+            if (ai.nextDecisionTick != timer.deadline) {
+                continue; // échéance remplacée
+            }
+            if (IsMember(timer.entity) && gCoordinator.IsEntityEnabled(timer.entity)) {
+                UpdateAIState(timer.entity, ai, gCoordinator.GetComponent<Transform>(timer.entity));
+            }
+            Schedule(timer.entity, now + TicksFor(ai.decisionCooldown, dt));
+        }
+
+        // Exécuter le comportement actuel, par lots (comportement, état) :
+        // une seule branche de mouvement par lot au lieu d'une par IA
+        GroupByState();
+        for (std::size_t group = 0; group + 1 < mGroupStart.size(); ++group) {
+            if (mGroupStart[group] == mGroupStart[group + 1]) {
+                continue;
+            }
+            const Behavior& behavior = mBehaviors.Get(static_cast<std::uint8_t>(group / AI_STATE_COUNT));
+            ExecuteGroup(behavior.actions[group % AI_STATE_COUNT], mGroupStart[group], mGroupStart[group + 1]);
+        }
+
+        mCheckedTick = gCoordinator.MarkChangesSeen();
+    }
+
+    // Appelé par lot quand des entités quittent le système (mort, perte
+    // d'un composant) : sans ça, une IA garde l'id d'une cible détruite et
+    // lit le Transform d'une entité morte ou réutilisée.
+    void ForgetTargets(const std::vector<Entity>& removed) {
+        std::bitset<MAX_ENTITIES> gone;
+        for (Entity entity : removed) {
+            gone.set(entity);
+        }
         for (Entity entity : entities) {
-            auto& ai = gCoordinator.GetComponent<AIController>(entity);
-            auto& transform = gCoordinator.GetComponent<Transform>(entity);
-            auto& velocity = gCoordinator.GetComponent<Velocity>(entity);
-            
-            ai.decisionTimer += dt;
-            
-            // Prendre des décisions périodiquement
-            if (ai.decisionTimer >= ai.decisionCooldown) {
-                ai.decisionTimer = 0.f;
-                UpdateAIState(entity, ai, transform);
+            auto& ai = gCoordinator.GetComponentUntracked<AIController>(entity);
+            if (ai.target != MAX_ENTITIES && gone.test(ai.target)) {
+                ai.target = MAX_ENTITIES;
+                ai.currentState = AIController::State::Patrolling;
             }
-            
-            // Exécuter le comportement actuel
-            ExecuteBehavior(entity, ai, transform, velocity);
         }
     }
     
 private:
+    bool IsMember(Entity entity) const {
+        return (gCoordinator.GetSignature(entity) & signature) == signature;
+    }
+
+    void Schedule(Entity entity, std::uint32_t deadline) {
+        gCoordinator.GetComponentUntracked<AIController>(entity).nextDecisionTick = deadline;
+        mWheel.Schedule(entity, deadline);
+    }
+
     void UpdateAIState(Entity entity, AIController& ai, const Transform& transform) {
         // Vérifier la santé pour fuir si nécessaire
         auto& health = gCoordinator.GetComponent<Health>(entity);
@@ -109,40 +206,64 @@ private:
         }
     }
     
-    void ExecuteBehavior(Entity entity, const AIController& ai, 
-                        const Transform& transform, Velocity& velocity) {
-        switch (ai.currentState) {
-            case AIController::State::Idle:
-                velocity.vx = 0.f;
-                velocity.vy = 0.f;
-                break;
-                
-            case AIController::State::Patrolling:
-                // Simple patrol: déplacement lent aléatoire
-                velocity.vx = 50.f;
-                velocity.vy = 0.f;
-                break;
-                
-            case AIController::State::Chasing:
-                if (ai.target != MAX_ENTITIES) {
-                    MoveTowardsTarget(entity, ai.target, velocity, 150.f);
+    // Tri par dénombrement des IA actives selon (comportement, état) dans
+    // mGrouped ; le lot `g` occupe [mGroupStart[g], mGroupStart[g + 1]).
+    void GroupByState() {
+        mGroupStart.assign(mBehaviors.Size() * AI_STATE_COUNT + 1, 0);
+        mKeys.clear();
+        mActive.clear();
+        for (Entity entity : gCoordinator.Enabled(entities)) {
+            const auto& ai = gCoordinator.GetComponent<AIController>(entity);
+            std::size_t behavior = ai.behavior < mBehaviors.Size() ? ai.behavior : 0;
+            std::size_t key = behavior * AI_STATE_COUNT + static_cast<std::size_t>(ai.currentState);
+            mActive.push_back(entity);
+            mKeys.push_back(static_cast<std::uint32_t>(key));
+            ++mGroupStart[key + 1];
+        }
+        for (std::size_t group = 1; group < mGroupStart.size(); ++group) {
+            mGroupStart[group] += mGroupStart[group - 1];
+        }
+        mGrouped.resize(mActive.size());
+        mCursor.assign(mGroupStart.begin(), mGroupStart.end() - 1);
+        for (std::size_t i = 0; i < mActive.size(); ++i) {
+            mGrouped[mCursor[mKeys[i]]++] = mActive[i];
+        }
+    }
+
+    void ExecuteGroup(const StateAction& action, std::size_t begin, std::size_t end) {
+        switch (action.motion) {
+            case Motion::Stop:
+                for (std::size_t i = begin; i < end; ++i) {
+                    auto& velocity = gCoordinator.WriteComponent<Velocity>(mGrouped[i]);
+                    velocity.vx = 0.f;
+                    velocity.vy = 0.f;
                 }
                 break;
-                
-            case AIController::State::Fleeing:
-                if (ai.target != MAX_ENTITIES) {
-                    MoveAwayFromTarget(entity, ai.target, velocity, 200.f);
-                } else {
-                    velocity.vx = -100.f;
-                    velocity.vy = 0.f;
+
+            case Motion::Drift:
+                for (std::size_t i = begin; i < end; ++i) {
+                    auto& velocity = gCoordinator.WriteComponent<Velocity>(mGrouped[i]);
+                    velocity.vx = action.vx;
+                    velocity.vy = action.vy;
                 }
                 break;
-                
-            case AIController::State::Attacking:
-                // Ralentir pour attaquer
-                velocity.vx = 0.f;
-                velocity.vy = 0.f;
+
+            case Motion::Seek:
+            case Motion::Flee: {
+                float direction = action.motion == Motion::Seek ? 1.f : -1.f;
+                for (std::size_t i = begin; i < end; ++i) {
+                    Entity entity = mGrouped[i];
+                    Entity target = gCoordinator.GetComponent<AIController>(entity).target;
+                    auto& velocity = gCoordinator.WriteComponent<Velocity>(entity);
+                    if (target != MAX_ENTITIES) {
+                        MoveRelativeToTarget(entity, target, velocity, action.speed * direction);
+                    } else if (action.driftWithoutTarget) {
+                        velocity.vx = action.vx;
+                        velocity.vy = action.vy;
+                    }
+                }
                 break;
+            }
         }
     }
     
@@ -154,7 +275,7 @@ private:
         
         // Parcourir toutes les entités avec Team et Transform
         // (Dans une vraie implémentation, vous voudriez un système de requête plus efficace)
-        for (Entity other : entities) {
+        for (Entity other : gCoordinator.Enabled(entities)) {
             if (other == self) continue;
             
             auto& otherTeam = gCoordinator.GetComponent<Team>(other);
@@ -178,7 +299,8 @@ private:
         return std::sqrt(dx * dx + dy * dy);
     }
     
-    void MoveTowardsTarget(Entity self, Entity target, Velocity& velocity, float speed) {
+    // Vers la cible si `speed` > 0, à l'opposé sinon.
+    void MoveRelativeToTarget(Entity self, Entity target, Velocity& velocity, float speed) {
         const auto& selfTransform = gCoordinator.GetComponent<Transform>(self);
         const auto& targetTransform = gCoordinator.GetComponent<Transform>(target);
         
@@ -191,47 +313,162 @@ private:
             velocity.vy = (dy / dist) * speed;
         }
     }
-    
-    void MoveAwayFromTarget(Entity self, Entity target, Velocity& velocity, float speed) {
-        const auto& selfTransform = gCoordinator.GetComponent<Transform>(self);
-        const auto& targetTransform = gCoordinator.GetComponent<Transform>(target);
-        
-        float dx = selfTransform.x - targetTransform.x;
-        float dy = selfTransform.y - targetTransform.y;
-        float dist = std::sqrt(dx * dx + dy * dy);
-        
-        if (dist > 0.f) {
-            velocity.vx = (dx / dist) * speed;
-            velocity.vy = (dy / dist) * speed;
-        }
-    }
+
+    BehaviorLibrary mBehaviors;
+    TimerWheel mWheel;
+    std::vector<TimerWheel::Timer> mExpired;
+    std::uint32_t mCheckedTick{};
+    // Regroupement par (comportement, état), réutilisé d'un tick à l'autre
+    std::vector<Entity> mActive;
+    std::vector<std::uint32_t> mKeys;
+    std::vector<Entity> mGrouped;
+    std::vector<std::size_t> mGroupStart;
+    std::vector<std::size_t> mCursor;
 };
 
 // === Spawner System ===
 class SpawnerSystem : public System {
 public:
+    SpawnerSystem() : mProjectilePool(gCoordinator.CreatePool()) {}
+
+    // Projectiles détruits recyclés (désactivés puis réutilisés au tir
+    // suivant) au lieu d'être supprimés puis recréés.
+    void SetProjectilePooling(bool enabled) {
+        mProjectilePooling = enabled;
+    }
+
+    bool GetProjectilePooling() const {
+        return mProjectilePooling;
+    }
+
+    std::size_t GetParkedProjectiles() const {
+        return mProjectilePool->GetParkedCount();
+    }
+
+    void SetPatterns(PatternLibrary patterns) {
+        mPatterns = std::move(patterns);
+    }
+
+    const PatternLibrary& GetPatterns() const {
+        return mPatterns;
+    }
+
+    // Projectiles tirés en Ballistic (position calculée, sortie d'écran
+    // planifiée) plutôt que déplacés par MovementSystem à chaque tick.
+    void SetBallisticProjectiles(bool enabled) {
+        mBallisticProjectiles = enabled;
+    }
+
+    bool GetBallisticProjectiles() const {
+        return mBallisticProjectiles;
+    }
+
+    // Spawn venu de l'extérieur de la simulation (vague de niveau, rejoué
+    // depuis ReplayRecorder::RecordSpawn) : ennemi ou powerup immobile,
+    // configuré comme par un Spawner. Les projectiles n'existent qu'au
+    // tir d'un Spawner : MAX_ENTITIES pour eux ou un type inconnu.
+    Entity SpawnExternal(Spawner::SpawnType type, float x, float y) {
+        if (type != Spawner::SpawnType::Enemy && type != Spawner::SpawnType::Powerup) {
+            return MAX_ENTITIES;
+        }
+        Entity entity = gCoordinator.CreateEntity();
+        gCoordinator.AddComponent(entity, Transform{x, y, 0.f});
+        gCoordinator.AddComponent(entity, Velocity{});
+        if (type == Spawner::SpawnType::Enemy) {
+            SetupEnemy(entity);
+        } else {
+            SetupPowerup(entity);
+        }
+        return entity;
+    }
+
+    // Comme pour l'IA, seuls les spawners dont le cooldown expire ce tick
+    // sont touchés.
     void Update(float dt) {
-        for (Entity entity : entities) {
-            auto& spawner = gCoordinator.GetComponent<Spawner>(entity);
-            
-            spawner.spawnTimer += dt;
-            
-            if (spawner.spawnTimer >= spawner.spawnCooldown) {
-                spawner.spawnTimer = 0.f;
-                
-                // Vérifier si on peut encore spawn
-                if (spawner.maxSpawns == -1 || spawner.spawnCount < spawner.maxSpawns) {
-                    SpawnEntity(entity, spawner);
-                    spawner.spawnCount++;
-                }
+        std::uint32_t now = gCoordinator.GetTick();
+        std::uint32_t since = mCheckedTick;
+        mDt = dt;
+
+        mWheel.Rewind(now);
+        gCoordinator.ForEachChanged<Spawner>(since, [&](Entity entity, const Spawner& spawner) {
+            std::uint32_t deadline = spawner.nextSpawnTick;
+            if (deadline == 0) {
+                deadline = now + TicksFor(spawner.spawnCooldown - spawner.spawnTimer, dt);
             }
+            Schedule(entity, deadline);
+        });
+
+        mExpired.clear();
+        mWheel.Advance(now, mExpired);
+        for (const auto& timer : mExpired) {
+            if (!gCoordinator.HasComponent<Spawner>(timer.entity)) {
+                continue;
+            }
+            auto& spawner = gCoordinator.GetComponentUntracked<Spawner>(timer.entity);
+            if (spawner.nextSpawnTick != timer.deadline) {
+                continue; // échéance remplacée
+            }
+
+            // Vérifier si on peut encore spawn
+            if (IsMember(timer.entity) && gCoordinator.IsEntityEnabled(timer.entity) &&
+                (spawner.maxSpawns == -1 || spawner.spawnCount < spawner.maxSpawns)) {
+                SpawnVolley(timer.entity, spawner);
+                spawner.spawnCount++;
+            }
+            Schedule(timer.entity, now + TicksFor(spawner.spawnCooldown, dt));
         }
+
+        mCheckedTick = gCoordinator.MarkChangesSeen();
     }
     
 private:
-    void SpawnEntity(Entity spawner, const Spawner& spawnerComp) {
+    bool IsMember(Entity entity) const {
+        return (gCoordinator.GetSignature(entity) & signature) == signature;
+    }
+
+    void Schedule(Entity entity, std::uint32_t deadline) {
+        gCoordinator.GetComponentUntracked<Spawner>(entity).nextSpawnTick = deadline;
+        mWheel.Schedule(entity, deadline);
+    }
+
+    // Toute la salve en une passe : vélocités calculées d'abord (pattern,
+    // visée), puis projectiles réactivés ou créés à la suite.
+    void SpawnVolley(Entity spawner, const Spawner& spawnerComp) {
+        const BulletPattern& pattern = mPatterns.Get(spawnerComp.pattern);
+        float aim = pattern.aimed ? AimOffset(spawner, spawnerComp) : 0.f;
+        mVolley.clear();
+        for (int rank = 0; rank < pattern.count; ++rank) {
+            mVolley.push_back(PatternVelocity(pattern, spawnerComp, spawnerComp.spawnCount, rank, aim));
+        }
+
         const auto& spawnerTransform = gCoordinator.GetComponent<Transform>(spawner);
-        
+        for (const Velocity& velocity : mVolley) {
+            SpawnEntity(spawner, spawnerComp, spawnerTransform, velocity);
+        }
+    }
+
+    // Écart entre la direction de tir du spawner et sa cible d'IA.
+    float AimOffset(Entity spawner, const Spawner& spawnerComp) {
+        if (!gCoordinator.HasComponent<AIController>(spawner)) {
+            return 0.f;
+        }
+        Entity target = gCoordinator.GetComponent<AIController>(spawner).target;
+        if (target == MAX_ENTITIES || !gCoordinator.HasComponent<Transform>(target)) {
+            return 0.f;
+        }
+        const auto& from = gCoordinator.GetComponent<Transform>(spawner);
+        const auto& to = gCoordinator.GetComponent<Transform>(target);
+        return std::atan2(to.y - from.y, to.x - from.x) -
+            std::atan2(spawnerComp.spawnVelocityY, spawnerComp.spawnVelocityX);
+    }
+
+    void SpawnEntity(Entity spawner, const Spawner& spawnerComp, const Transform& spawnerTransform,
+                     const Velocity& spawnVelocity) {
+        if (mProjectilePooling && spawnerComp.typeToSpawn == Spawner::SpawnType::Projectile &&
+            ReuseProjectile(spawner, spawnerComp, spawnerTransform, spawnVelocity)) {
+            return;
+        }
+
         Entity newEntity = gCoordinator.CreateEntity();
         
         // Position du spawn
@@ -241,15 +478,12 @@ private:
         gCoordinator.AddComponent(newEntity, transform);
         
         // Vélocité du spawn
-        Velocity velocity;
-        velocity.vx = spawnerComp.spawnVelocityX;
-        velocity.vy = spawnerComp.spawnVelocityY;
-        gCoordinator.AddComponent(newEntity, velocity);
+        gCoordinator.AddComponent(newEntity, spawnVelocity);
         
         // Configuration selon le type
         switch (spawnerComp.typeToSpawn) {
             case Spawner::SpawnType::Projectile:
-                SetupProjectile(newEntity, spawner);
+                SetupProjectile(newEntity, spawner, spawnVelocity);
                 break;
             case Spawner::SpawnType::Enemy:
                 SetupEnemy(newEntity);
@@ -260,7 +494,7 @@ private:
         }
     }
     
-    void SetupProjectile(Entity entity, Entity owner) {
+    void SetupProjectile(Entity entity, Entity owner, const Velocity& velocity) {
         // Collider
         Collider collider;
         collider.shape = Collider::Shape::Circle;
@@ -287,6 +521,56 @@ private:
         Boundary boundary;
         boundary.destroy = true;
         gCoordinator.AddComponent(entity, boundary);
+
+        if (mBallisticProjectiles) {
+            gCoordinator.AddComponent(entity, MakeBallistic(velocity));
+        }
+
+        if (mProjectilePooling) {
+            mProjectilePool->Track(entity);
+        }
+    }
+
+    // Réactive un projectile parqué : seuls les champs propres au tir
+    // changent, Collider/Damager/Boundary sont identiques pour tous.
+    bool ReuseProjectile(Entity spawner, const Spawner& spawnerComp, const Transform& spawnerTransform,
+                         const Velocity& spawnVelocity) {
+        Entity entity = mProjectilePool->Acquire();
+        if (entity == MAX_ENTITIES) {
+            return false;
+        }
+
+        auto& transform = gCoordinator.WriteComponent<Transform>(entity);
+        transform.x = spawnerTransform.x + spawnerComp.spawnOffsetX;
+        transform.y = spawnerTransform.y + spawnerComp.spawnOffsetY;
+        transform.rotation = 0.f;
+
+        gCoordinator.WriteComponent<Velocity>(entity) = spawnVelocity;
+
+        gCoordinator.WriteComponent<Team>(entity).teamID = gCoordinator.GetComponent<Team>(spawner).teamID;
+        gCoordinator.WriteComponent<Lifetime>(entity) = Lifetime{3.f};
+
+        // Le projectile parqué peut dater d'un réglage différent
+        bool ballistic = gCoordinator.HasComponent<Ballistic>(entity);
+        if (mBallisticProjectiles && ballistic) {
+            gCoordinator.WriteComponent<Ballistic>(entity) = MakeBallistic(spawnVelocity);
+        } else if (mBallisticProjectiles) {
+            gCoordinator.AddComponent(entity, MakeBallistic(spawnVelocity));
+        } else if (ballistic) {
+            gCoordinator.RemoveComponent<Ballistic>(entity);
+        }
+        gCoordinator.SetEntityEnabled(entity, true);
+        return true;
+    }
+
+    // Le Transform du projectile est l'origine, posée ce tick : il avance
+    // d'un pas au tick suivant, comme avec MovementSystem.
+    Ballistic MakeBallistic(const Velocity& velocity) const {
+        Ballistic ballistic;
+        ballistic.stepX = velocity.vx * mDt;
+        ballistic.stepY = velocity.vy * mDt;
+        ballistic.spawnTick = gCoordinator.GetTick();
+        return ballistic;
     }
     
     void SetupEnemy(Entity entity) {
@@ -336,149 +620,451 @@ private:
         lifetime.timeLeft = 10.f;
         gCoordinator.AddComponent(entity, lifetime);
     }
+
+    std::shared_ptr<EntityPool> mProjectilePool;
+    bool mProjectilePooling{true};
+    bool mBallisticProjectiles{true};
+    float mDt{0.f};
+    PatternLibrary mPatterns;
+    std::vector<Velocity> mVolley; // vélocités de la salve en cours
+    TimerWheel mWheel;
+    std::vector<TimerWheel::Timer> mExpired;
+    std::uint32_t mCheckedTick{};
 };
 
 // === Collision System ===
+// Détection seule : les composants sont lus, jamais modifiés, et chaque
+// coup est émis en DamageEvent pour DamageSystem.
+// Chaque corps est balayé du début à la fin du tick (détection continue) :
+// un projectile rapide ne traverse plus une cible entre deux ticks. Les
+// paires candidates viennent d'un tri des boîtes balayées selon x.
 class CollisionSystem : public System {
 public:
-    void Update() {
-        for (size_t i = 0; i < entities.size(); ++i) {
-            for (size_t j = i + 1; j < entities.size(); ++j) {
-                Entity e1 = entities[i];
-                Entity e2 = entities[j];
-                
-                const auto& t1 = gCoordinator.GetComponent<Transform>(e1);
-                const auto& t2 = gCoordinator.GetComponent<Transform>(e2);
-                const auto& c1 = gCoordinator.GetComponent<Collider>(e1);
-                const auto& c2 = gCoordinator.GetComponent<Collider>(e2);
-                
-                if (CheckCollision(t1, c1, t2, c2)) {
-                    ResolveCollision(e1, e2);
+    // Test aux seules positions de fin de tick, comme avant la détection
+    // continue (comparaison de coût).
+    void SetContinuous(bool enabled) {
+        mContinuous = enabled;
+    }
+
+    void Update(float dt) {
+        mHealthType = gCoordinator.GetComponentType<Health>();
+        mVelocityType = gCoordinator.GetComponentType<Velocity>();
+        mBallisticType = gCoordinator.GetComponentType<Ballistic>();
+        mActive.clear();
+        mBodies.clear();
+        for (Entity entity : gCoordinator.Enabled(entities)) {
+            mBodies.push_back(MakeBody(entity, static_cast<std::uint32_t>(mActive.size()), dt));
+            mActive.push_back(entity);
+        }
+        std::sort(mBodies.begin(), mBodies.end(), [](const Body& a, const Body& b) {
+            return a.minX < b.minX || (a.minX == b.minX && a.index < b.index);
+        });
+
+        // Coups rangés par (i, j) dans l'ordre de mActive : les événements
+        // sortent dans le même ordre qu'un parcours de toutes les paires.
+        std::pmr::vector<std::uint64_t> hits(gCoordinator.Frame().Resource());
+        for (std::size_t a = 0; a < mBodies.size(); ++a) {
+            const Body& first = mBodies[a];
+            for (std::size_t b = a + 1; b < mBodies.size() && mBodies[b].minX <= first.maxX; ++b) {
+                const Body& second = mBodies[b];
+                // Deux projectiles ne s'endommagent pas, une même team non plus
+                if ((!first.hittable && !second.hittable) || first.team == second.team ||
+                    second.minY > first.maxY || second.maxY < first.minY) {
+                    continue;
+                }
+                if (Overlap(first, second)) {
+                    std::uint64_t i = std::min(first.index, second.index);
+                    std::uint64_t j = std::max(first.index, second.index);
+                    hits.push_back((i << 32) | j);
                 }
             }
         }
+        std::sort(hits.begin(), hits.end());
+
+        auto& damage = gCoordinator.Events<DamageEvent>();
+        for (std::uint64_t hit : hits) {
+            Entity e1 = mActive[hit >> 32];
+            Entity e2 = mActive[hit & 0xffffffffu];
+            EmitDamage(e1, gCoordinator.GetComponent<Collider>(e1), e2, gCoordinator.GetComponent<Collider>(e2),
+                damage);
+        }
     }
     
 private:
-    bool CheckCollision(const Transform& t1, const Collider& c1,
-                       const Transform& t2, const Collider& c2) {
-        float dx = t2.x - t1.x;
-        float dy = t2.y - t1.y;
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        // Simple circle collision
-        if (c1.shape == Collider::Shape::Circle && c2.shape == Collider::Shape::Circle) {
-            return distance < (c1.radius + c2.radius);
+    // Corps balayé sur le tick : de (x0, y0) à (x1, y1). Un cercle a
+    // halfWidth = halfHeight = 0 et radius > 0, une boîte (AABB, sans
+    // rotation) radius = 0.
+    struct Body {
+        std::uint32_t index; // rang dans mActive
+        int team;
+        bool hittable; // a une Health
+        float x0, y0, x1, y1;
+        float halfWidth, halfHeight, radius;
+        float minX, maxX, minY, maxY;
+    };
+
+    Body MakeBody(Entity entity, std::uint32_t index, float dt) {
+        const Signature& signature = gCoordinator.GetSignature(entity);
+        const auto& collider = gCoordinator.GetComponent<Collider>(entity);
+        Transform current = CurrentTransform(entity);
+        Transform previous = mContinuous ? PreviousTransform(entity, signature, current, dt) : current;
+
+        Body body;
+        body.index = index;
+        body.team = gCoordinator.GetComponent<Team>(entity).teamID;
+        body.hittable = signature.test(mHealthType);
+        body.x0 = previous.x;
+        body.y0 = previous.y;
+        body.x1 = current.x;
+        body.y1 = current.y;
+        bool circle = collider.shape == Collider::Shape::Circle;
+        body.halfWidth = circle ? 0.f : collider.width / 2.f;
+        body.halfHeight = circle ? 0.f : collider.height / 2.f;
+        body.radius = circle ? collider.radius : 0.f;
+        float extentX = body.halfWidth + body.radius;
+        float extentY = body.halfHeight + body.radius;
+        body.minX = std::min(body.x0, body.x1) - extentX;
+        body.maxX = std::max(body.x0, body.x1) + extentX;
+        body.minY = std::min(body.y0, body.y1) - extentY;
+        body.maxY = std::max(body.y0, body.y1) + extentY;
+        return body;
+    }
+
+    // Position au tick précédent. La collision suit MovementSystem : un
+    // corps mobile vient de parcourir vitesse * dt, un projectile
+    // balistique un pas (aucun le tick de son tir).
+    Transform PreviousTransform(Entity entity, const Signature& signature, const Transform& current, float dt) const {
+        std::uint32_t tick = gCoordinator.GetTick();
+        if (signature.test(mBallisticType)) {
+            const auto& ballistic = gCoordinator.GetComponent<Ballistic>(entity);
+            if (tick == ballistic.spawnTick) {
+                return current;
+            }
+            return BallisticPosition(gCoordinator.GetComponent<Transform>(entity), ballistic, tick - 1);
         }
-        
-        // Box collision approximée par cercle
-        float r1 = (c1.shape == Collider::Shape::Circle) ? c1.radius : 
-                   std::sqrt(c1.width * c1.width + c1.height * c1.height) / 2.f;
-        float r2 = (c2.shape == Collider::Shape::Circle) ? c2.radius : 
-                   std::sqrt(c2.width * c2.width + c2.height * c2.height) / 2.f;
-        
-        return distance < (r1 + r2);
+        if (!signature.test(mVelocityType)) {
+            return current;
+        }
+        const auto& velocity = gCoordinator.GetComponent<Velocity>(entity);
+        return Transform{current.x - velocity.vx * dt, current.y - velocity.vy * dt, current.rotation};
+    }
+
+    // Mouvement relatif : `second` vu depuis `first`, qui reste fixe, testé
+    // contre leur somme de Minkowski (voir SweptRoundedBoxHit).
+    static bool Overlap(const Body& first, const Body& second) {
+        return SweptRoundedBoxHit(second.x0 - first.x0, second.y0 - first.y0,
+            (second.x1 - second.x0) - (first.x1 - first.x0), (second.y1 - second.y0) - (first.y1 - first.y0),
+            first.halfWidth + second.halfWidth, first.halfHeight + second.halfHeight, first.radius + second.radius);
     }
     
-    void ResolveCollision(Entity e1, Entity e2) {
-        // Récupérer les teams
-        auto& team1 = gCoordinator.GetComponent<Team>(e1);
-        auto& team2 = gCoordinator.GetComponent<Team>(e2);
-        
+    void EmitDamage(Entity e1, const Collider& c1, Entity e2, const Collider& c2,
+                    EventQueue<DamageEvent>& damage) {
         // Ignorer les collisions entre même team (tir ami)
-        if (team1.teamID == team2.teamID) return;
+        if (gCoordinator.GetComponent<Team>(e1).teamID == gCoordinator.GetComponent<Team>(e2).teamID) return;
         
-        // Vérifier si e1 peut endommager e2
-        auto& damager1 = gCoordinator.GetComponent<Damager>(e1);
-        auto& health2 = gCoordinator.GetComponent<Health>(e2);
-        
-        if (damager1.damage > 0 && !health2.invincible && health2.invincibilityTimer <= 0.f) {
-            health2.current -= damager1.damage;
-            health2.invincibilityTimer = 0.5f; // 0.5s d'invincibilité
-            
-            // Détruire le projectile après impact
-            auto& collider1 = gCoordinator.GetComponent<Collider>(e1);
-            if (!collider1.isTrigger) {
-                gCoordinator.RequestDestroyEntity(e1);
-            }
+        // e1 peut endommager e2, et inversement (collision bidirectionnelle)
+        int damage1 = gCoordinator.GetComponent<Damager>(e1).damage;
+        if (damage1 > 0) {
+            damage.Emit({e2, e1, damage1, !c1.isTrigger});
         }
-        
-        // Vérifier si e2 peut endommager e1 (collision bidirectionnelle)
-        auto& damager2 = gCoordinator.GetComponent<Damager>(e2);
-        auto& health1 = gCoordinator.GetComponent<Health>(e1);
-        
-        if (damager2.damage > 0 && !health1.invincible && health1.invincibilityTimer <= 0.f) {
-            health1.current -= damager2.damage;
-            health1.invincibilityTimer = 0.5f;
-            
-            auto& collider2 = gCoordinator.GetComponent<Collider>(e2);
-            if (!collider2.isTrigger) {
-                gCoordinator.RequestDestroyEntity(e2);
+        int damage2 = gCoordinator.GetComponent<Damager>(e2).damage;
+        if (damage2 > 0) {
+            damage.Emit({e1, e2, damage2, !c2.isTrigger});
+        }
+    }
+
+    bool mContinuous{true};
+    ComponentType mHealthType{};
+    ComponentType mVelocityType{};
+    ComponentType mBallisticType{};
+    std::vector<Entity> mActive; // entités actives du tick courant
+    std::vector<Body> mBodies; // leurs corps balayés, triés par minX
+};
+
+// === Damage System ===
+// Applique les DamageEvent du tick, triés par cible : les Health sont
+// parcourus dans l'ordre des ids. Le tri est stable, donc pour une même
+// cible seul le premier coup dans l'ordre de détection passe, les suivants
+// tombent sur l'invincibilité qu'il vient de déclencher.
+class DamageSystem : public System {
+public:
+    void Update() {
+        auto& queue = gCoordinator.Events<DamageEvent>();
+        queue.Swap();
+        const auto& events = queue.Events();
+
+        // Clés (cible, rang d'émission) dans l'arène du tick : les trier
+        // donne l'ordre du tri stable, sans tampon temporaire sur le tas.
+        std::pmr::vector<std::uint64_t> order(gCoordinator.Frame().Resource());
+        order.reserve(events.size());
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            order.push_back((static_cast<std::uint64_t>(events[i].target) << 32) | i);
+        }
+        std::sort(order.begin(), order.end());
+
+        for (std::uint64_t key : order) {
+            const auto& event = events[key & 0xffffffffu];
+            if (!gCoordinator.HasComponent<Health>(event.target)) {
+                continue;
+            }
+            const auto& health = gCoordinator.GetComponent<Health>(event.target);
+            if (health.invincible || health.invincibilityTimer > 0.f) {
+                continue;
+            }
+
+            auto& damaged = gCoordinator.WriteComponent<Health>(event.target);
+            damaged.current -= event.amount;
+            damaged.invincibilityTimer = 0.5f; // 0.5s d'invincibilité
+            damaged.invincibleUntil = 0;
+
+            // Détruire le projectile après impact
+            if (event.destroySource) {
+                gCoordinator.RequestDestroyEntity(event.source);
             }
         }
     }
 };
 
 // === Lifetime System ===
+// Les expirations sont rangées dans une roue de timers : seuls les
+// projectiles qui expirent ce tick sont touchés.
 class LifetimeSystem : public System {
 public:
     void Update(float dt) {
-        for (Entity entity : entities) {
-            auto& lifetime = gCoordinator.GetComponent<Lifetime>(entity);
-            lifetime.timeLeft -= dt;
-            
-            if (lifetime.timeLeft <= 0.f) {
-                gCoordinator.RequestDestroyEntity(entity);
+        std::uint32_t now = gCoordinator.GetTick();
+        std::uint32_t since = mCheckedTick;
+
+        // Durées nouvelles ou réécrites (ajout, projectile réutilisé, monde
+        // rechargé)
+        mWheel.Rewind(now);
+        gCoordinator.ForEachChanged<Lifetime>(since, [&](Entity entity, const Lifetime& lifetime) {
+            std::uint32_t deadline = lifetime.expireTick;
+            if (deadline == 0) {
+                deadline = now + TicksFor(lifetime.timeLeft, dt);
+                gCoordinator.GetComponentUntracked<Lifetime>(entity).expireTick = deadline;
+            }
+            mWheel.Schedule(entity, deadline);
+        });
+
+        mExpired.clear();
+        mWheel.Advance(now, mExpired);
+        for (const auto& timer : mExpired) {
+            if (!gCoordinator.HasComponent<Lifetime>(timer.entity) ||
+                gCoordinator.GetComponent<Lifetime>(timer.entity).expireTick != timer.deadline) {
+                continue; // composant retiré ou durée réécrite
+            }
+            if (gCoordinator.IsEntityEnabled(timer.entity)) {
+                gCoordinator.RequestDestroyEntity(timer.entity);
+            } else if (!gCoordinator.IsParked(timer.entity)) {
+                // En pause : détruite au premier tick où elle est réactivée.
+                // Un projectile parqué, lui, reçoit une nouvelle durée au tir.
+                mWheel.Schedule(timer.entity, timer.deadline);
             }
         }
+
+        mCheckedTick = gCoordinator.MarkChangesSeen();
     }
+
+private:
+    TimerWheel mWheel;
+    std::vector<TimerWheel::Timer> mExpired;
+    std::uint32_t mCheckedTick{};
 };
 
 // === Boundary System ===
+// Ne revoit que les entités dont le Transform ou le Boundary a changé
+// depuis le passage précédent : une entité immobile ne coûte rien.
 class BoundarySystem : public System {
 public:
     void Update() {
-        for (Entity entity : entities) {
-            auto& transform = gCoordinator.GetComponent<Transform>(entity);
-            const auto& boundary = gCoordinator.GetComponent<Boundary>(entity);
-            
-            if (boundary.wrap) {
-                // Wraparound
-                if (transform.x < boundary.minX) transform.x = boundary.maxX;
-                if (transform.x > boundary.maxX) transform.x = boundary.minX;
-                if (transform.y < boundary.minY) transform.y = boundary.maxY;
-                if (transform.y > boundary.maxY) transform.y = boundary.minY;
-            } else if (boundary.destroy) {
-                // Détruire si hors limites
-                if (transform.x < boundary.minX || transform.x > boundary.maxX ||
-                    transform.y < boundary.minY || transform.y > boundary.maxY) {
-                    gCoordinator.RequestDestroyEntity(entity);
+        std::uint32_t since = mCheckedTick;
+
+        gCoordinator.ForEachChanged<Transform>(since, [&](Entity entity, const Transform& transform) {
+            if (IsMember(entity)) {
+                Check(entity, transform, gCoordinator.GetComponent<Boundary>(entity));
+            }
+        });
+        gCoordinator.ForEachChanged<Boundary>(since, [&](Entity entity, const Boundary& boundary) {
+            if (IsMember(entity)) {
+                Check(entity, gCoordinator.GetComponent<Transform>(entity), boundary);
+            }
+        });
+
+        mCheckedTick = gCoordinator.MarkChangesSeen();
+    }
+
+private:
+    bool IsMember(Entity entity) const {
+        return (gCoordinator.GetSignature(entity) & signature) == signature && gCoordinator.IsEntityEnabled(entity);
+    }
+
+    void Check(Entity entity, const Transform& current, const Boundary& boundary) {
+        bool outside = current.x < boundary.minX || current.x > boundary.maxX ||
+            current.y < boundary.minY || current.y > boundary.maxY;
+        if (!outside) {
+            return;
+        }
+
+        if (boundary.destroy && !boundary.wrap) {
+            // Détruire si hors limites
+            gCoordinator.RequestDestroyEntity(entity);
+            return;
+        }
+
+        auto& transform = gCoordinator.WriteComponent<Transform>(entity);
+        if (boundary.wrap) {
+            // Wraparound
+            if (transform.x < boundary.minX) transform.x = boundary.maxX;
+            if (transform.x > boundary.maxX) transform.x = boundary.minX;
+            if (transform.y < boundary.minY) transform.y = boundary.maxY;
+            if (transform.y > boundary.maxY) transform.y = boundary.minY;
+        } else {
+            // Clamp aux limites
+            transform.x = std::clamp(transform.x, boundary.minX, boundary.maxX);
+            transform.y = std::clamp(transform.y, boundary.minY, boundary.maxY);
+        }
+    }
+
+    std::uint32_t mCheckedTick{};
+};
+
+// === Ballistic System ===
+// Les projectiles balistiques ne bougent pas dans l'ECS : leur sortie du
+// Boundary est calculée une fois au tir et rangée dans une roue de timers,
+// comme les expirations de LifetimeSystem.
+class BallisticSystem : public System {
+public:
+    void Update() {
+        std::uint32_t now = gCoordinator.GetTick();
+        std::uint32_t since = mCheckedTick;
+
+        // Tirs nouveaux ou réécrits, limites modifiées
+        mWheel.Rewind(now);
+        gCoordinator.ForEachChanged<Ballistic>(since, [&](Entity entity, const Ballistic& ballistic) {
+            if (IsMember(entity)) {
+                Schedule(entity, ballistic.exitTick);
+            }
+        });
+        gCoordinator.ForEachChanged<Boundary>(since, [&](Entity entity, const Boundary&) {
+            if (IsMember(entity)) {
+                Schedule(entity, 0);
+            }
+        });
+
+        mExpired.clear();
+        mWheel.Advance(now, mExpired);
+        for (const auto& timer : mExpired) {
+            if (!gCoordinator.HasComponent<Ballistic>(timer.entity) ||
+                gCoordinator.GetComponent<Ballistic>(timer.entity).exitTick != timer.deadline) {
+                continue; // composant retiré ou tir réécrit
+            }
+            if (gCoordinator.IsEntityEnabled(timer.entity)) {
+                gCoordinator.RequestDestroyEntity(timer.entity);
+            } else if (!gCoordinator.IsParked(timer.entity)) {
+                // En pause (même poolé) : sort au premier tick actif.
+                mWheel.Schedule(timer.entity, timer.deadline);
+            }
+        }
+
+        mCheckedTick = gCoordinator.MarkChangesSeen();
+    }
+
+private:
+    bool IsMember(Entity entity) const {
+        return (gCoordinator.GetSignature(entity) & signature) == signature;
+    }
+
+    // `exitTick` déjà calculé (monde rechargé) ou 0 pour le recalculer.
+    void Schedule(Entity entity, std::uint32_t exitTick) {
+        auto& ballistic = gCoordinator.GetComponentUntracked<Ballistic>(entity);
+        if (exitTick == 0) {
+            exitTick = Ballistic::NEVER;
+            if (gCoordinator.HasComponent<Boundary>(entity)) {
+                const auto& boundary = gCoordinator.GetComponent<Boundary>(entity);
+                if (boundary.destroy && !boundary.wrap) {
+                    exitTick = BallisticExitTick(gCoordinator.GetComponent<Transform>(entity), ballistic, boundary);
                 }
-            } else {
-                // Clamp aux limites
-                transform.x = std::clamp(transform.x, boundary.minX, boundary.maxX);
-                transform.y = std::clamp(transform.y, boundary.minY, boundary.maxY);
             }
+            ballistic.exitTick = exitTick;
+        }
+        if (exitTick != Ballistic::NEVER) {
+            mWheel.Schedule(entity, exitTick);
         }
     }
+
+    TimerWheel mWheel;
+    std::vector<TimerWheel::Timer> mExpired;
+    std::uint32_t mCheckedTick{};
 };
 
 // === Health System ===
+// Ne revoit que les Health modifiés depuis le passage précédent (dégâts,
+// ajout) ; la fin d'invincibilité passe par une roue de timers.
 class HealthSystem : public System {
 public:
     void Update(float dt) {
-        for (Entity entity : entities) {
-            auto& health = gCoordinator.GetComponent<Health>(entity);
-            
-            if (health.invincibilityTimer > 0.f) {
-                health.invincibilityTimer -= dt;
+        std::uint32_t now = gCoordinator.GetTick();
+        std::uint32_t since = mCheckedTick;
+
+        // Morts en attente de réactivation
+        std::size_t kept = 0;
+        for (Entity entity : mPendingDeaths) {
+            if (!gCoordinator.HasComponent<Health>(entity) || gCoordinator.GetComponent<Health>(entity).current > 0) {
+                mPendingDeath.reset(entity);
+                continue;
             }
-            
-            if (health.current <= 0) {
+            if (gCoordinator.IsEntityEnabled(entity)) {
+                mPendingDeath.reset(entity);
                 gCoordinator.RequestDestroyEntity(entity);
+            } else {
+                mPendingDeaths[kept++] = entity;
             }
         }
+        mPendingDeaths.resize(kept);
+
+        mWheel.Rewind(now);
+        gCoordinator.ForEachChanged<Health>(since, [&](Entity entity, const Health& health) {
+            if (health.current <= 0) {
+                if (gCoordinator.IsEntityEnabled(entity)) {
+                    gCoordinator.RequestDestroyEntity(entity);
+                } else if (!mPendingDeath.test(entity)) {
+                    // Une Health réécrite pendant la pause repasse ici : une seule entrée
+                    mPendingDeath.set(entity);
+                    mPendingDeaths.push_back(entity);
+                }
+            }
+            if (health.invincibilityTimer > 0.f) {
+                std::uint32_t deadline = health.invincibleUntil;
+                if (deadline == 0) {
+                    deadline = now + TicksFor(health.invincibilityTimer, dt);
+                    gCoordinator.GetComponentUntracked<Health>(entity).invincibleUntil = deadline;
+                }
+                mWheel.Schedule(entity, deadline);
+            }
+        });
+
+        // Fin d'invincibilité (le temps s'écoule aussi pour une entité en
+        // pause)
+        mExpired.clear();
+        mWheel.Advance(now, mExpired);
+        for (const auto& timer : mExpired) {
+            if (gCoordinator.HasComponent<Health>(timer.entity) &&
+                gCoordinator.GetComponent<Health>(timer.entity).invincibleUntil == timer.deadline) {
+                auto& health = gCoordinator.WriteComponent<Health>(timer.entity);
+                health.invincibilityTimer = 0.f;
+                health.invincibleUntil = 0;
+            }
+        }
+
+        mCheckedTick = gCoordinator.MarkChangesSeen();
     }
+
+private:
+    TimerWheel mWheel;
+    std::vector<TimerWheel::Timer> mExpired;
+    std::vector<Entity> mPendingDeaths;
+    std::bitset<MAX_ENTITIES> mPendingDeath; // membres de mPendingDeaths
+    std::uint32_t mCheckedTick{};
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ecs {
+
+// Appends values of arbitrary bit width (LSB first) to a byte vector.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : mOut(out) {}
+
+    void Write(std::uint32_t value, unsigned bits)
+    {
+        assert(bits <= 32 && "Bit width too large");
+        std::uint64_t pending = bits < 32 ? value & ((1u << bits) - 1u) : value;
+        while (bits > 0) {
+            if (mBitOffset == 0) {
+                mOut.push_back(0);
+            }
+            unsigned take = std::min(8u - mBitOffset, bits);
+            mOut.back() |= static_cast<std::uint8_t>((pending & ((1u << take) - 1u)) << mBitOffset);
+            pending >>= take;
+            bits -= take;
+            mBitOffset = (mBitOffset + take) & 7u;
+        }
+    }
+
+    void WriteSigned(std::int32_t value, unsigned bits)
+    {
+        Write(static_cast<std::uint32_t>(value), bits);
+    }
+
+    void WriteBool(bool value)
+    {
+        Write(value ? 1u : 0u, 1);
+    }
+
+private:
+    std::vector<std::uint8_t>& mOut;
+    unsigned mBitOffset{};
+};
+
+// Reads values written by BitWriter; any overrun latches Failed().
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, std::size_t size) : mData(data), mBitSize(size * 8) {}
+
+    std::uint32_t Read(unsigned bits)
+    {
+        assert(bits <= 32 && "Bit width too large");
+        if (mBitPos + bits > mBitSize) {
+            mFailed = true;
+            mBitPos = mBitSize;
+            return 0;
+        }
+        std::uint64_t value = 0;
+        unsigned shift = 0;
+        while (shift < bits) {
+            unsigned offset = static_cast<unsigned>(mBitPos & 7u);
+            unsigned take = std::min(8u - offset, bits - shift);
+            std::uint64_t chunk = (mData[mBitPos >> 3] >> offset) & ((1u << take) - 1u);
+            value |= chunk << shift;
+            shift += take;
+            mBitPos += take;
+        }
+        return static_cast<std::uint32_t>(value);
+    }
+
+    std::int32_t ReadSigned(unsigned bits)
+    {
+        std::uint32_t value = Read(bits);
+        if (bits < 32 && (value & (1u << (bits - 1)))) {
+            value |= ~((1u << bits) - 1u);
+        }
+        return static_cast<std::int32_t>(value);
+    }
+
+    bool ReadBool()
+    {
+        return Read(1) != 0;
+    }
+
+    bool Failed() const { return mFailed; }
+
+private:
+    const std::uint8_t* mData;
+    std::size_t mBitSize;
+    std::size_t mBitPos{};
+    bool mFailed{false};
+};
+
+} // namespace ecs
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "snapshot.hpp"
+
+namespace ecs {
+
+inline constexpr std::size_t DEFAULT_SNAPSHOT_BUDGET = 1024; // octets par tick et par client
+
+// Zone visible par un client (par défaut le terrain de jeu 800x600 de Boundary).
+struct ClientView {
+    float minX{0.f};
+    float maxX{800.f};
+    float minY{0.f};
+    float maxY{600.f};
+    float margin{64.f};
+    std::size_t budgetBytes{DEFAULT_SNAPSHOT_BUDGET};
+
+    bool Contains(float x, float y) const
+    {
+        return x >= minX - margin && x <= maxX + margin &&
+               y >= minY - margin && y <= maxY + margin;
+    }
+};
+
+// Choisit, pour un client, les entités du snapshot monde à lui envoyer.
+//
+// Les entités hors de la vue sont retirées. Les entités visibles qui ont
+// changé accumulent de la priorité à chaque tick ; les plus prioritaires
+// sont envoyées tant que le budget le permet, les autres gardent leur état
+// de base (0 octet) et reprennent leur priorité au tick suivant.
+class InterestManager {
+public:
+    std::shared_ptr<const Snapshot> Filter(const Snapshot& world, const Snapshot* baseline,
+                                           const ClientView& view, float dt)
+    {
+        std::shared_ptr<Snapshot> out = Recycle();
+        out->tick = world.tick;
+        out->entities.clear();
+        out->entities.reserve(world.entities.size());
+        mCandidates.clear();
+
+        static const std::vector<EntityState> empty{};
+        const auto& base = baseline ? baseline->entities : empty;
+        std::size_t budgetBits = view.budgetBytes * 8;
+        std::size_t usedBits = 0;
+        std::size_t j = 0;
+
+        for (std::size_t i = 0; i < world.entities.size(); ++i) {
+            const EntityState& state = world.entities[i];
+            while (j < base.size() && base[j].entity < state.entity) {
+                usedBits += REMOVE_BITS;
+                ++j;
+            }
+            const EntityState* previous = (j < base.size() && base[j].entity == state.entity) ? &base[j++] : nullptr;
+
+            Transform transform = state.GetTransform();
+            if (!view.Contains(transform.x, transform.y)) {
+                mPriority[state.entity] = 0.f;
+                usedBits += previous ? REMOVE_BITS : 0;
+                continue;
+            }
+
+            std::size_t cost = EstimateBits(state, previous);
+            if (cost == 0) {
+                mPriority[state.entity] = 0.f;
+                out->entities.push_back(state);
+                continue;
+            }
+
+            mPriority[state.entity] += Weight(state, view) * dt;
+            mCandidates.push_back(Candidate{i, previous, cost, mPriority[state.entity]});
+        }
+        usedBits += (base.size() - j) * REMOVE_BITS;
+
+        std::sort(mCandidates.begin(), mCandidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+
+        for (const Candidate& candidate : mCandidates) {
+            const EntityState& state = world.entities[candidate.index];
+            if (usedBits + candidate.cost <= budgetBits) {
+                usedBits += candidate.cost;
+                mPriority[state.entity] = 0.f;
+                out->entities.push_back(state);
+            } else if (candidate.previous) {
+                out->entities.push_back(*candidate.previous);
+            }
+        }
+
+        std::sort(out->entities.begin(), out->entities.end(),
+            [](const EntityState& a, const EntityState& b) { return a.entity < b.entity; });
+        return out;
+    }
+
+    void Reset()
+    {
+        mPriority.fill(0.f);
+    }
+
+private:
+    // Comme SnapshotSystem::Capture : un snapshot filtré que ClientReplication
+    // ne garde plus comme envoyé ou comme baseline est réutilisé, avec la
+    // capacité de son vecteur.
+    std::shared_ptr<Snapshot> Recycle()
+    {
+        for (const auto& snapshot : mPool) {
+            if (snapshot.use_count() == 1) {
+                return snapshot;
+            }
+        }
+        mPool.push_back(std::make_shared<Snapshot>());
+        return mPool.back();
+    }
+
+    struct Candidate {
+        std::size_t index;
+        const EntityState* previous;
+        std::size_t cost;
+        float priority;
+    };
+
+    // Coût approximatif (op + id) d'une entrée du snapshot.
+    static constexpr std::size_t ENTRY_BITS = detail::SNAPSHOT_OP_BITS + 1 + detail::SMALL_ENTITY_DELTA_BITS;
+    static constexpr std::size_t REMOVE_BITS = ENTRY_BITS;
+
+    static std::size_t EstimateBits(const EntityState& state, const EntityState* previous)
+    {
+        if (!previous || previous->parts != state.parts) {
+            std::size_t bits = ENTRY_BITS + EntityState::PART_BITS + 2 * POSITION_BITS + ROTATION_BITS;
+            bits += (state.parts & EntityState::HasVelocity) ? 2 * VELOCITY_BITS : 0;
+            bits += (state.parts & EntityState::HasHealth) ? HEALTH_BITS : 0;
+            return bits;
+        }
+        std::uint8_t mask = state.ChangedFields(*previous);
+        if (mask == 0) {
+            return 0;
+        }
+        std::size_t bits = ENTRY_BITS + EntityState::FIELD_COUNT;
+        if (mask & EntityState::FieldX) bits += DeltaBits(state.x, previous->x, POSITION_BITS);
+        if (mask & EntityState::FieldY) bits += DeltaBits(state.y, previous->y, POSITION_BITS);
+        if (mask & EntityState::FieldRotation) bits += ROTATION_BITS;
+        if (mask & EntityState::FieldVX) bits += DeltaBits(state.vx, previous->vx, VELOCITY_BITS);
+        if (mask & EntityState::FieldVY) bits += DeltaBits(state.vy, previous->vy, VELOCITY_BITS);
+        if (mask & EntityState::FieldHealth) bits += DeltaBits(state.health, previous->health, HEALTH_BITS);
+        return bits;
+    }
+
+    static std::size_t DeltaBits(std::int32_t value, std::int32_t base, unsigned bits)
+    {
+        const std::int32_t limit = 1 << (SMALL_DELTA_BITS - 1);
+        std::int32_t delta = value - base;
+        return 1 + ((delta >= -limit && delta < limit) ? SMALL_DELTA_BITS : bits);
+    }
+
+    // Les vaisseaux (avec Health) passent avant les projectiles, et les
+    // entités proches du centre de la vue avant celles du bord.
+    static float Weight(const EntityState& state, const ClientView& view)
+    {
+        float weight = (state.parts & EntityState::HasHealth) ? 4.f : 1.f;
+        Transform transform = state.GetTransform();
+        float halfW = (view.maxX - view.minX) * 0.5f + view.margin;
+        float halfH = (view.maxY - view.minY) * 0.5f + view.margin;
+        float dx = std::abs(transform.x - (view.minX + view.maxX) * 0.5f) / halfW;
+        float dy = std::abs(transform.y - (view.minY + view.maxY) * 0.5f) / halfH;
+        return weight * (2.f - std::min(1.f, std::max(dx, dy)));
+    }
+
+    std::array<float, MAX_ENTITIES> mPriority{};
+    std::vector<Candidate> mCandidates{};
+    std::vector<std::shared_ptr<Snapshot>> mPool{};
+};
+
+} // namespace ecs
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "components.hpp"
+#include "ecs.hpp"
+#include "snapshot.hpp"
+
+namespace ecs {
+
+inline constexpr std::size_t INTERPOLATION_SAMPLES = 8;
+
+// Derniers états reçus du serveur, par entité serveur, et horloge de rendu
+// maintenue à `delay` secondes derrière le snapshot le plus récent.
+class InterpolationBuffer {
+public:
+    explicit InterpolationBuffer(float tickDt, float delay = 0.1f, float maxExtrapolation = 0.25f)
+        : mTickDt(tickDt), mDelay(delay), mMaxExtrapolation(maxExtrapolation),
+          mTracks(MAX_ENTITIES)
+    {
+    }
+
+    void Push(const Snapshot& snapshot)
+    {
+        double time = snapshot.tick * static_cast<double>(mTickDt);
+        if (mHasNewest && time <= mNewestTime) {
+            return;
+        }
+        for (const EntityState& state : snapshot.entities) {
+            Track& track = mTracks[state.entity];
+            if (!track.alive) {
+                track.count = 0;
+                track.alive = true;
+            }
+            Entry& entry = track.samples[track.head];
+            entry.time = time;
+            entry.transform = state.GetTransform();
+            entry.velocity = state.GetVelocity();
+            track.head = (track.head + 1) % INTERPOLATION_SAMPLES;
+            track.count = std::min(track.count + 1, INTERPOLATION_SAMPLES);
+            track.lastSeen = time;
+        }
+        for (Track& track : mTracks) {
+            if (track.alive && track.lastSeen < time) {
+                track.alive = false;
+            }
+        }
+
+        if (!mHasNewest) {
+            mRenderTime = time - mDelay;
+        }
+        mNewestTime = time;
+        mHasNewest = true;
+    }
+
+    // Avance l'horloge de rendu ; dérive corrigée en douceur vers la cible.
+    void Advance(float frameDt)
+    {
+        if (!mHasNewest) {
+            return;
+        }
+        double target = mNewestTime - mDelay;
+        double error = target - mRenderTime;
+        if (std::abs(error) > mDelay * 2.0) {
+            mRenderTime = target;
+            return;
+        }
+        double scale = std::clamp(1.0 + error * 0.5, 0.9, 1.1);
+        mRenderTime += frameDt * scale;
+    }
+
+    // Etat de l'entité serveur à l'instant de rendu courant.
+    bool Sample(Entity serverId, Transform& out) const
+    {
+        if (serverId >= MAX_ENTITIES) {
+            return false;
+        }
+        const Track& track = mTracks[serverId];
+        if (track.count == 0) {
+            return false;
+        }
+
+        const Entry* newest = &track.At(track.count - 1);
+        if (mRenderTime >= newest->time) {
+            float ahead = static_cast<float>(std::min(mRenderTime - newest->time, static_cast<double>(mMaxExtrapolation)));
+            out = newest->transform;
+            out.x += newest->velocity.vx * ahead;
+            out.y += newest->velocity.vy * ahead;
+            return true;
+        }
+        for (std::size_t i = track.count - 1; i > 0; --i) {
+            const Entry& from = track.At(i - 1);
+            const Entry& to = track.At(i);
+            if (from.time <= mRenderTime) {
+                float t = static_cast<float>((mRenderTime - from.time) / (to.time - from.time));
+                out.x = from.transform.x + (to.transform.x - from.transform.x) * t;
+                out.y = from.transform.y + (to.transform.y - from.transform.y) * t;
+                out.rotation = LerpAngle(from.transform.rotation, to.transform.rotation, t);
+                return true;
+            }
+        }
+        out = track.At(0).transform;
+        return true;
+    }
+
+    // Vrai tant que l'entité existe à l'instant de rendu.
+    bool IsAlive(Entity serverId) const
+    {
+        if (serverId >= MAX_ENTITIES) {
+            return false;
+        }
+        const Track& track = mTracks[serverId];
+        return track.count > 0 && (track.alive || mRenderTime <= track.lastSeen);
+    }
+
+    double GetRenderTime() const { return mRenderTime; }
+
+private:
+    struct Entry {
+        double time{};
+        Transform transform{};
+        Velocity velocity{};
+    };
+
+    struct Track {
+        std::array<Entry, INTERPOLATION_SAMPLES> samples{};
+        std::size_t head{};
+        std::size_t count{};
+        double lastSeen{};
+        bool alive{false};
+
+        // i = 0 : plus ancien échantillon conservé.
+        const Entry& At(std::size_t i) const
+        {
+            return samples[(head + INTERPOLATION_SAMPLES - count + i) % INTERPOLATION_SAMPLES];
+        }
+    };
+
+    static float LerpAngle(float from, float to, float t)
+    {
+        float delta = std::fmod(to - from + 540.f, 360.f) - 180.f;
+        return from + delta * t;
+    }
+
+    float mTickDt;
+    float mDelay;
+    float mMaxExtrapolation;
+    std::vector<Track> mTracks;
+    double mNewestTime{};
+    double mRenderTime{};
+    bool mHasNewest{false};
+};
+
+// Ecrit le Transform interpolé dans les entités locales répliquées.
+class InterpolationSystem : public System {
+public:
+    void Update(const InterpolationBuffer& buffer) {
+        for (Entity entity : gCoordinator.Enabled(entities)) {
+            const auto& networkId = gCoordinator.GetComponent<NetworkId>(entity);
+            auto& transform = gCoordinator.WriteComponent<Transform>(entity);
+            buffer.Sample(networkId.serverId, transform);
+        }
+    }
+};
+
+} // namespace ecs
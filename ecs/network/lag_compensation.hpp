@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ballistic.hpp"
+#include "components.hpp"
+#include "ecs.hpp"
+#include "overlap.hpp"
+
+namespace ecs {
+
+inline constexpr std::uint32_t LAG_HISTORY_TICKS = 32; // ~266 ms à 120 Hz
+
+// Historique des colliders sur les derniers ticks, en mémoire fixe
+// (LAG_HISTORY_TICKS x MAX_ENTITIES enregistrements alloués une fois).
+// Chaque frame est triée par x pour limiter une requête à une fenêtre.
+// Les formes sont celles de CollisionSystem (cercle ou boîte AABB) et le
+// test est le même, pour qu'un tir rembobiné touche ce que la collision
+// aurait touché.
+class LagCompensationSystem : public System {
+public:
+    // Cercle : halfWidth = halfHeight = 0 ; boîte : radius = 0.
+    struct ColliderRecord {
+        float x;
+        float y;
+        float halfWidth;
+        float halfHeight;
+        float radius;
+        std::uint16_t entity;
+        std::int16_t team;
+    };
+    static_assert(MAX_ENTITIES <= 0xFFFF, "ColliderRecord::entity is 16 bits");
+
+    LagCompensationSystem()
+        : mRecords(static_cast<std::size_t>(LAG_HISTORY_TICKS) * MAX_ENTITIES)
+    {
+    }
+
+    // A appeler une fois par tick, après MovementSystem.
+    void Record(std::uint32_t tick)
+    {
+        Frame& frame = mFrames[tick % LAG_HISTORY_TICKS];
+        frame.tick = tick;
+        frame.count = 0;
+        frame.maxExtentX = 0.f;
+        frame.valid = true;
+
+        ColliderRecord* records = FrameRecords(tick);
+        for (Entity entity : gCoordinator.Enabled(entities)) {
+            Transform transform = CurrentTransform(entity);
+            const auto& collider = gCoordinator.GetComponent<Collider>(entity);
+            const auto& team = gCoordinator.GetComponent<Team>(entity);
+            bool circle = collider.shape == Collider::Shape::Circle;
+            ColliderRecord record{transform.x, transform.y, circle ? 0.f : collider.width / 2.f,
+                circle ? 0.f : collider.height / 2.f, circle ? collider.radius : 0.f,
+                static_cast<std::uint16_t>(entity), static_cast<std::int16_t>(team.teamID)};
+
+            records[frame.count++] = record;
+            frame.maxExtentX = std::max(frame.maxExtentX, record.halfWidth + record.radius);
+        }
+        std::sort(records, records + frame.count,
+            [](const ColliderRecord& a, const ColliderRecord& b) { return a.x < b.x; });
+        mLatestTick = tick;
+    }
+
+    // Teste un cercle (ex: spawn d'un tir) contre le monde tel qu'il était
+    // au tick vu par le client. Les entités de `team` sont ignorées.
+    // Retourne l'entité touchée la plus proche, ou MAX_ENTITIES.
+    Entity RewindQuery(std::uint32_t viewTick, float x, float y, float radius, int team) const
+    {
+        const Frame* frame = FindFrame(viewTick);
+        if (!frame) {
+            return MAX_ENTITIES;
+        }
+
+        const ColliderRecord* records = FrameRecords(frame->tick);
+        const ColliderRecord* end = records + frame->count;
+        float reach = radius + frame->maxExtentX;
+        const ColliderRecord* it = std::lower_bound(records, end, x - reach,
+            [](const ColliderRecord& record, float value) { return record.x < value; });
+
+        Entity hit = MAX_ENTITIES;
+        float bestDist = 0.f;
+        for (; it != end && it->x <= x + reach; ++it) {
+            if (it->team == team) {
+                continue;
+            }
+            float dx = it->x - x;
+            float dy = it->y - y;
+            if (!SweptRoundedBoxHit(dx, dy, 0.f, 0.f, it->halfWidth, it->halfHeight, radius + it->radius)) {
+                continue;
+            }
+            float dist = dx * dx + dy * dy;
+            if (hit == MAX_ENTITIES || dist < bestDist) {
+                hit = it->entity;
+                bestDist = dist;
+            }
+        }
+        return hit;
+    }
+
+    // Tick le plus ancien encore disponible.
+    std::uint32_t GetOldestTick() const
+    {
+        return mLatestTick >= LAG_HISTORY_TICKS - 1 ? mLatestTick - (LAG_HISTORY_TICKS - 1) : 0;
+    }
+
+private:
+    struct Frame {
+        std::uint32_t tick{};
+        std::uint32_t count{};
+        float maxExtentX{}; // plus grand demi-côté + rayon en x
+        bool valid{false};
+    };
+
+    // Un tick trop ancien est ramené au plus ancien disponible (limite la
+    // compensation), un tick futur au plus récent.
+    const Frame* FindFrame(std::uint32_t tick) const
+    {
+        tick = std::clamp(tick, GetOldestTick(), mLatestTick);
+        const Frame& frame = mFrames[tick % LAG_HISTORY_TICKS];
+        return frame.valid && frame.tick == tick ? &frame : nullptr;
+    }
+
+    ColliderRecord* FrameRecords(std::uint32_t tick)
+    {
+        return mRecords.data() + static_cast<std::size_t>(tick % LAG_HISTORY_TICKS) * MAX_ENTITIES;
+    }
+
+    const ColliderRecord* FrameRecords(std::uint32_t tick) const
+    {
+        return mRecords.data() + static_cast<std::size_t>(tick % LAG_HISTORY_TICKS) * MAX_ENTITIES;
+    }
+
+    std::vector<ColliderRecord> mRecords;
+    std::array<Frame, LAG_HISTORY_TICKS> mFrames{};
+    std::uint32_t mLatestTick{};
+};
+
+} // namespace ecs
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "bit_stream.hpp"
+#include "components.hpp"
+#include "ecs.hpp"
+#include "systems.hpp"
+
+namespace ecs {
+
+inline constexpr std::uint32_t INPUT_BUFFER_SIZE = 128;
+inline constexpr std::uint32_t INPUT_REDUNDANCY = 8; // inputs renvoyés par paquet
+inline constexpr unsigned INPUT_COUNT_BITS = 4;
+static_assert(INPUT_REDUNDANCY < (1u << INPUT_COUNT_BITS), "INPUT_COUNT_BITS too small");
+
+// Input d'un joueur pour un tick de simulation donné.
+struct InputCommand {
+    std::uint32_t tick{};
+    PlayerInput input{};
+};
+
+// Sérialise les derniers inputs (redondance contre la perte de paquets).
+inline void WriteInputs(const std::vector<InputCommand>& commands, std::vector<std::uint8_t>& out)
+{
+    BitWriter writer(out);
+    std::uint32_t count = std::min<std::uint32_t>(static_cast<std::uint32_t>(commands.size()), INPUT_REDUNDANCY);
+    std::size_t first = commands.size() - count;
+    writer.Write(count, INPUT_COUNT_BITS);
+    if (count == 0) {
+        return;
+    }
+    writer.Write(commands[first].tick, 32);
+    for (std::size_t i = first; i < commands.size(); ++i) {
+        writer.Write(static_cast<std::uint32_t>(commands[i].input.direction), 4);
+        writer.WriteBool(commands[i].input.firePressed);
+    }
+}
+
+// Les inputs envoyés sont consécutifs : seul le premier tick est transmis.
+inline bool ReadInputs(const std::uint8_t* data, std::size_t size, std::vector<InputCommand>& out)
+{
+    BitReader reader(data, size);
+    out.clear();
+    std::uint32_t count = reader.Read(INPUT_COUNT_BITS);
+    if (count == 0) {
+        return !reader.Failed();
+    }
+    std::uint32_t tick = reader.Read(32);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        InputCommand command;
+        command.tick = tick + i;
+        command.input.direction = static_cast<int>(reader.Read(4));
+        command.input.firePressed = reader.ReadBool();
+        if (command.input.direction < 1 || command.input.direction > 9) {
+            return false;
+        }
+        out.push_back(command);
+    }
+    return !reader.Failed();
+}
+
+// Côté client : applique immédiatement les inputs du joueur local avec
+// InputSystem + MovementSystem restreints à son entité, puis rejoue les
+// inputs non acquittés à partir du Transform autoritaire du serveur.
+class ClientPrediction {
+public:
+    ClientPrediction(std::shared_ptr<InputSystem> input, std::shared_ptr<MovementSystem> movement,
+                     Entity local, float tickDt)
+        : mInputSystem(std::move(input)), mMovementSystem(std::move(movement)),
+          mSubset{local}, mTickDt(tickDt)
+    {
+    }
+
+    void Predict(std::uint32_t tick, const PlayerInput& input)
+    {
+        Slot& slot = mHistory[tick % INPUT_BUFFER_SIZE];
+        slot.command = InputCommand{tick, input};
+        slot.valid = true;
+        Step(input);
+        slot.predicted = gCoordinator.GetComponent<Transform>(mSubset.front());
+        mLatestTick = tick;
+        if (!mHasInput) {
+            mOldestTick = tick;
+            mHasInput = true;
+        } else if (mLatestTick - mOldestTick >= INPUT_BUFFER_SIZE) {
+            mOldestTick = mLatestTick - INPUT_BUFFER_SIZE + 1;
+        }
+    }
+
+    // `processedTick` est le dernier tick d'input appliqué par le serveur,
+    // `server` l'état du joueur juste après ce tick.
+    void Reconcile(std::uint32_t processedTick, const Transform& server, float tolerance = 0.5f)
+    {
+        if (!mHasInput || processedTick < mOldestTick || processedTick > mLatestTick) {
+            return;
+        }
+        for (std::uint32_t tick = mOldestTick; tick <= processedTick; ++tick) {
+            mHistory[tick % INPUT_BUFFER_SIZE].valid = tick == processedTick;
+        }
+        mOldestTick = processedTick + 1;
+
+        const Slot& acked = mHistory[processedTick % INPUT_BUFFER_SIZE];
+        if (acked.command.tick == processedTick &&
+            std::abs(acked.predicted.x - server.x) <= tolerance &&
+            std::abs(acked.predicted.y - server.y) <= tolerance) {
+            return;
+        }
+
+        ++mCorrections;
+        gCoordinator.WriteComponent<Transform>(mSubset.front()) = server;
+        for (std::uint32_t tick = mOldestTick; tick <= mLatestTick; ++tick) {
+            Slot& slot = mHistory[tick % INPUT_BUFFER_SIZE];
+            if (!slot.valid || slot.command.tick != tick) {
+                continue;
+            }
+            Step(slot.command.input);
+            slot.predicted = gCoordinator.GetComponent<Transform>(mSubset.front());
+        }
+    }
+
+    // Inputs à envoyer au serveur (les plus récents non acquittés).
+    std::vector<InputCommand> PendingInputs() const
+    {
+        std::vector<InputCommand> pending;
+        if (!mHasInput) {
+            return pending;
+        }
+        std::uint32_t first = mLatestTick + 1 - std::min(mLatestTick + 1 - mOldestTick, INPUT_REDUNDANCY);
+        for (std::uint32_t tick = first; tick <= mLatestTick; ++tick) {
+            const Slot& slot = mHistory[tick % INPUT_BUFFER_SIZE];
+            if (slot.valid && slot.command.tick == tick) {
+                pending.push_back(slot.command);
+            }
+        }
+        return pending;
+    }
+
+    std::uint32_t GetCorrectionCount() const { return mCorrections; }
+
+private:
+    struct Slot {
+        InputCommand command{};
+        Transform predicted{};
+        bool valid{false};
+    };
+
+    void Step(const PlayerInput& input)
+    {
+        gCoordinator.WriteComponent<PlayerInput>(mSubset.front()) = input;
+        mInputSystem->UpdateEntities(mSubset);
+        mMovementSystem->UpdateEntities(mSubset, mTickDt);
+    }
+
+    std::shared_ptr<InputSystem> mInputSystem;
+    std::shared_ptr<MovementSystem> mMovementSystem;
+    std::vector<Entity> mSubset;
+    float mTickDt;
+    std::array<Slot, INPUT_BUFFER_SIZE> mHistory{};
+    std::uint32_t mOldestTick{};
+    std::uint32_t mLatestTick{};
+    bool mHasInput{false};
+    std::uint32_t mCorrections{};
+};
+
+// Côté serveur : file des inputs reçus d'un joueur, consommés un par tick
+// dans l'ordre. Un input perdu répète le précédent.
+class ServerInputBuffer {
+public:
+    void Receive(const std::vector<InputCommand>& commands)
+    {
+        for (const InputCommand& command : commands) {
+            if (mHasProcessed && command.tick <= mProcessedTick) {
+                continue;
+            }
+            if (mHasProcessed && command.tick >= mProcessedTick + INPUT_BUFFER_SIZE) {
+                continue;
+            }
+            Slot& slot = mBuffer[command.tick % INPUT_BUFFER_SIZE];
+            slot.command = command;
+            slot.valid = true;
+            if (!mHasNewest || command.tick > mNewestTick) {
+                mNewestTick = command.tick;
+                mHasNewest = true;
+            }
+        }
+    }
+
+    // Applique l'input du prochain tick au composant PlayerInput du joueur.
+    bool ApplyNext(Entity player)
+    {
+        std::uint32_t next = mHasProcessed ? mProcessedTick + 1 : FirstReceivedTick();
+        Slot& slot = mBuffer[next % INPUT_BUFFER_SIZE];
+        if (!slot.valid || slot.command.tick != next) {
+            // Input perdu mais des inputs plus récents sont arrivés : on garde
+            // le précédent plutôt que de bloquer le joueur.
+            if (!mHasProcessed || !mHasNewest || mNewestTick <= next) {
+                return false;
+            }
+        } else {
+            gCoordinator.WriteComponent<PlayerInput>(player) = slot.command.input;
+            slot.valid = false;
+        }
+        mProcessedTick = next;
+        mHasProcessed = true;
+        return true;
+    }
+
+    std::uint32_t GetProcessedTick() const { return mProcessedTick; }
+    bool HasProcessed() const { return mHasProcessed; }
+
+private:
+    struct Slot {
+        InputCommand command{};
+        bool valid{false};
+    };
+
+    std::uint32_t FirstReceivedTick() const
+    {
+        std::uint32_t first = std::numeric_limits<std::uint32_t>::max();
+        for (const Slot& slot : mBuffer) {
+            if (slot.valid && slot.command.tick < first) {
+                first = slot.command.tick;
+            }
+        }
+        return first;
+    }
+
+    std::array<Slot, INPUT_BUFFER_SIZE> mBuffer{};
+    std::uint32_t mProcessedTick{};
+    bool mHasProcessed{false};
+    std::uint32_t mNewestTick{};
+    bool mHasNewest{false};
+};
+
+} // namespace ecs
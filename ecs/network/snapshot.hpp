@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ballistic.hpp"
+#include "bit_stream.hpp"
+#include "components.hpp"
+#include "ecs.hpp"
+
+namespace ecs {
+
+// Quantification partagée client/serveur.
+inline constexpr float POSITION_SCALE = 8.f;   // 1/8 px
+inline constexpr unsigned POSITION_BITS = 20;
+inline constexpr float ROTATION_SCALE = 4096.f / 360.f;
+inline constexpr unsigned ROTATION_BITS = 12;
+inline constexpr float VELOCITY_SCALE = 4.f;   // 1/4 px/s
+inline constexpr unsigned VELOCITY_BITS = 16;
+inline constexpr unsigned HEALTH_BITS = 16;
+inline constexpr unsigned ENTITY_BITS = 13;
+inline constexpr unsigned SMALL_DELTA_BITS = 8;
+static_assert(MAX_ENTITIES <= (1u << ENTITY_BITS), "ENTITY_BITS too small for MAX_ENTITIES");
+
+inline constexpr std::uint32_t SNAPSHOT_BUFFER_SIZE = 32;
+inline constexpr std::uint32_t NO_BASELINE = 0xFFFFFFFFu;
+
+inline std::int32_t Quantize(float value, float scale, unsigned bits)
+{
+    const long limit = (1L << (bits - 1)) - 1;
+    long q = std::lround(value * scale);
+    return static_cast<std::int32_t>(std::clamp(q, -limit - 1, limit));
+}
+
+inline std::uint16_t QuantizeRotation(float degrees)
+{
+    float wrapped = std::fmod(degrees, 360.f);
+    if (wrapped < 0.f) {
+        wrapped += 360.f;
+    }
+    return static_cast<std::uint16_t>(std::lround(wrapped * ROTATION_SCALE) & ((1u << ROTATION_BITS) - 1u));
+}
+
+// Etat répliqué (quantifié) d'une entité.
+struct EntityState {
+    enum Field : std::uint8_t {
+        FieldX = 1 << 0,
+        FieldY = 1 << 1,
+        FieldRotation = 1 << 2,
+        FieldVX = 1 << 3,
+        FieldVY = 1 << 4,
+        FieldHealth = 1 << 5,
+    };
+    static constexpr unsigned FIELD_COUNT = 6;
+
+    enum Part : std::uint8_t {
+        HasVelocity = 1 << 0,
+        HasHealth = 1 << 1,
+    };
+    static constexpr unsigned PART_BITS = 2;
+
+    Entity entity{};
+    std::uint8_t parts{};
+    std::int32_t x{};
+    std::int32_t y{};
+    std::uint16_t rotation{};
+    std::int32_t vx{};
+    std::int32_t vy{};
+    std::int32_t health{};
+
+    Transform GetTransform() const
+    {
+        return Transform{x / POSITION_SCALE, y / POSITION_SCALE, rotation / ROTATION_SCALE};
+    }
+
+    Velocity GetVelocity() const
+    {
+        return Velocity{vx / VELOCITY_SCALE, vy / VELOCITY_SCALE};
+    }
+
+    std::uint8_t ChangedFields(const EntityState& base) const
+    {
+        std::uint8_t mask = 0;
+        if (x != base.x) mask |= FieldX;
+        if (y != base.y) mask |= FieldY;
+        if (rotation != base.rotation) mask |= FieldRotation;
+        if (vx != base.vx) mask |= FieldVX;
+        if (vy != base.vy) mask |= FieldVY;
+        if (health != base.health) mask |= FieldHealth;
+        return mask;
+    }
+};
+
+// Etat complet du monde répliqué à un tick donné, trié par entité.
+struct Snapshot {
+    std::uint32_t tick{};
+    std::vector<EntityState> entities{};
+};
+
+// Capture l'état de toutes les entités actives ayant un Transform.
+class SnapshotSystem : public System {
+public:
+    std::shared_ptr<const Snapshot> Capture(std::uint32_t tick)
+    {
+        std::shared_ptr<Snapshot> snapshot = Recycle();
+        snapshot->tick = tick;
+        snapshot->entities.clear();
+        snapshot->entities.reserve(entities.size());
+
+        for (Entity entity : gCoordinator.Enabled(entities)) {
+            Transform transform = CurrentTransform(entity);
+            EntityState state;
+            state.entity = entity;
+            state.x = Quantize(transform.x, POSITION_SCALE, POSITION_BITS);
+            state.y = Quantize(transform.y, POSITION_SCALE, POSITION_BITS);
+            state.rotation = QuantizeRotation(transform.rotation);
+
+            if (gCoordinator.HasComponent<Velocity>(entity)) {
+                const auto& velocity = gCoordinator.GetComponent<Velocity>(entity);
+                state.parts |= EntityState::HasVelocity;
+                state.vx = Quantize(velocity.vx, VELOCITY_SCALE, VELOCITY_BITS);
+                state.vy = Quantize(velocity.vy, VELOCITY_SCALE, VELOCITY_BITS);
+            }
+            if (gCoordinator.HasComponent<Health>(entity)) {
+                state.parts |= EntityState::HasHealth;
+                state.health = Quantize(static_cast<float>(gCoordinator.GetComponent<Health>(entity).current), 1.f, HEALTH_BITS);
+            }
+            snapshot->entities.push_back(state);
+        }
+
+        std::sort(snapshot->entities.begin(), snapshot->entities.end(),
+            [](const EntityState& a, const EntityState& b) { return a.entity < b.entity; });
+        return snapshot;
+    }
+
+private:
+    // Snapshot que plus personne ne référence (baselines des clients
+    // comprises), sinon un nouveau : en régime établi, la capture réutilise
+    // l'objet et la capacité de son vecteur, sans allocation.
+    std::shared_ptr<Snapshot> Recycle()
+    {
+        for (const auto& snapshot : mPool) {
+            if (snapshot.use_count() == 1) {
+                return snapshot;
+            }
+        }
+        mPool.push_back(std::make_shared<Snapshot>());
+        return mPool.back();
+    }
+
+    std::vector<std::shared_ptr<Snapshot>> mPool{};
+};
+
+namespace detail {
+
+enum class SnapshotOp : std::uint8_t { Update, Create, Remove, End };
+inline constexpr unsigned SNAPSHOT_OP_BITS = 2;
+inline constexpr unsigned SMALL_ENTITY_DELTA_BITS = 4;
+
+inline void WriteEntityId(BitWriter& writer, Entity entity, Entity& previous, bool& first)
+{
+    Entity delta = entity - previous - 1;
+    bool small = !first && entity > previous && delta < (1u << SMALL_ENTITY_DELTA_BITS);
+    writer.WriteBool(small);
+    writer.Write(small ? delta : entity, small ? SMALL_ENTITY_DELTA_BITS : ENTITY_BITS);
+    previous = entity;
+    first = false;
+}
+
+// Faux si l'id est hors limites ou ne suit pas strictement le précédent :
+// WriteEntityId émet des ids croissants, et la fusion avec la base dans
+// ReadSnapshot en dépend (un doublon ou un désordre venu d'un paquet forgé
+// dupliquerait ou perdrait des entités).
+inline bool ReadEntityId(BitReader& reader, Entity& entity, Entity& previous, bool& first)
+{
+    bool small = reader.ReadBool();
+    entity = small ? previous + 1 + reader.Read(SMALL_ENTITY_DELTA_BITS) : reader.Read(ENTITY_BITS);
+    if (entity >= MAX_ENTITIES || (!first && entity <= previous)) {
+        return false;
+    }
+    previous = entity;
+    first = false;
+    return true;
+}
+
+// Petit delta sur 8 bits si possible, sinon valeur complète.
+inline void WriteDeltaValue(BitWriter& writer, std::int32_t value, std::int32_t base, unsigned bits)
+{
+    std::int32_t delta = value - base;
+    const std::int32_t limit = 1 << (SMALL_DELTA_BITS - 1);
+    bool small = delta >= -limit && delta < limit;
+    writer.WriteBool(small);
+    writer.WriteSigned(small ? delta : value, small ? SMALL_DELTA_BITS : bits);
+}
+
+inline std::int32_t ReadDeltaValue(BitReader& reader, std::int32_t base, unsigned bits)
+{
+    bool small = reader.ReadBool();
+    return small ? base + reader.ReadSigned(SMALL_DELTA_BITS) : reader.ReadSigned(bits);
+}
+
+inline void WriteFullState(BitWriter& writer, const EntityState& state)
+{
+    writer.Write(state.parts, EntityState::PART_BITS);
+    writer.WriteSigned(state.x, POSITION_BITS);
+    writer.WriteSigned(state.y, POSITION_BITS);
+    writer.Write(state.rotation, ROTATION_BITS);
+    if (state.parts & EntityState::HasVelocity) {
+        writer.WriteSigned(state.vx, VELOCITY_BITS);
+        writer.WriteSigned(state.vy, VELOCITY_BITS);
+    }
+    if (state.parts & EntityState::HasHealth) {
+        writer.WriteSigned(state.health, HEALTH_BITS);
+    }
+}
+
+inline void ReadFullState(BitReader& reader, EntityState& state)
+{
+    state.parts = static_cast<std::uint8_t>(reader.Read(EntityState::PART_BITS));
+    state.x = reader.ReadSigned(POSITION_BITS);
+    state.y = reader.ReadSigned(POSITION_BITS);
+    state.rotation = static_cast<std::uint16_t>(reader.Read(ROTATION_BITS));
+    state.vx = state.vy = state.health = 0;
+    if (state.parts & EntityState::HasVelocity) {
+        state.vx = reader.ReadSigned(VELOCITY_BITS);
+        state.vy = reader.ReadSigned(VELOCITY_BITS);
+    }
+    if (state.parts & EntityState::HasHealth) {
+        state.health = reader.ReadSigned(HEALTH_BITS);
+    }
+}
+
+inline void WriteDeltaState(BitWriter& writer, const EntityState& state, const EntityState& base, std::uint8_t mask)
+{
+    writer.Write(mask, EntityState::FIELD_COUNT);
+    if (mask & EntityState::FieldX) WriteDeltaValue(writer, state.x, base.x, POSITION_BITS);
+    if (mask & EntityState::FieldY) WriteDeltaValue(writer, state.y, base.y, POSITION_BITS);
+    if (mask & EntityState::FieldRotation) writer.Write(state.rotation, ROTATION_BITS);
+    if (mask & EntityState::FieldVX) WriteDeltaValue(writer, state.vx, base.vx, VELOCITY_BITS);
+    if (mask & EntityState::FieldVY) WriteDeltaValue(writer, state.vy, base.vy, VELOCITY_BITS);
+    if (mask & EntityState::FieldHealth) WriteDeltaValue(writer, state.health, base.health, HEALTH_BITS);
+}
+
+inline void ReadDeltaState(BitReader& reader, EntityState& state)
+{
+    const EntityState base = state;
+    std::uint8_t mask = static_cast<std::uint8_t>(reader.Read(EntityState::FIELD_COUNT));
+    if (mask & EntityState::FieldX) state.x = ReadDeltaValue(reader, base.x, POSITION_BITS);
+    if (mask & EntityState::FieldY) state.y = ReadDeltaValue(reader, base.y, POSITION_BITS);
+    if (mask & EntityState::FieldRotation) state.rotation = static_cast<std::uint16_t>(reader.Read(ROTATION_BITS));
+    if (mask & EntityState::FieldVX) state.vx = ReadDeltaValue(reader, base.vx, VELOCITY_BITS);
+    if (mask & EntityState::FieldVY) state.vy = ReadDeltaValue(reader, base.vy, VELOCITY_BITS);
+    if (mask & EntityState::FieldHealth) state.health = ReadDeltaValue(reader, base.health, HEALTH_BITS);
+}
+
+} // namespace detail
+
+// Encode `current` relativement à `baseline` (ou complet si nullptr).
+// Seules les entités créées, supprimées ou modifiées sont écrites.
+inline void WriteSnapshot(const Snapshot& current, const Snapshot* baseline, std::vector<std::uint8_t>& out)
+{
+    using detail::SnapshotOp;
+    BitWriter writer(out);
+    writer.Write(current.tick, 32);
+    writer.Write(baseline ? baseline->tick : NO_BASELINE, 32);
+
+    static const std::vector<EntityState> empty{};
+    const auto& base = baseline ? baseline->entities : empty;
+    Entity previous = 0;
+    bool first = true;
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    auto writeOp = [&](SnapshotOp op, Entity entity) {
+        writer.Write(static_cast<std::uint32_t>(op), detail::SNAPSHOT_OP_BITS);
+        detail::WriteEntityId(writer, entity, previous, first);
+    };
+
+    while (i < current.entities.size() || j < base.size()) {
+        if (j == base.size() || (i < current.entities.size() && current.entities[i].entity < base[j].entity)) {
+            writeOp(SnapshotOp::Create, current.entities[i].entity);
+            detail::WriteFullState(writer, current.entities[i]);
+            ++i;
+        } else if (i == current.entities.size() || base[j].entity < current.entities[i].entity) {
+            writeOp(SnapshotOp::Remove, base[j].entity);
+            ++j;
+        } else {
+            const EntityState& state = current.entities[i];
+            if (state.parts != base[j].parts) {
+                writeOp(SnapshotOp::Create, state.entity);
+                detail::WriteFullState(writer, state);
+            } else if (std::uint8_t mask = state.ChangedFields(base[j]); mask != 0) {
+                writeOp(SnapshotOp::Update, state.entity);
+                detail::WriteDeltaState(writer, state, base[j], mask);
+            }
+            ++i;
+            ++j;
+        }
+    }
+    writer.Write(static_cast<std::uint32_t>(SnapshotOp::End), detail::SNAPSHOT_OP_BITS);
+}
+
+// Lit les ticks d'en-tête sans décoder le reste.
+inline bool PeekSnapshotTicks(const std::uint8_t* data, std::size_t size, std::uint32_t& tick, std::uint32_t& baselineTick)
+{
+    BitReader reader(data, size);
+    tick = reader.Read(32);
+    baselineTick = reader.Read(32);
+    return !reader.Failed();
+}
+
+// Reconstruit un snapshot complet à partir de `baseline` et du delta.
+inline bool ReadSnapshot(const std::uint8_t* data, std::size_t size, const Snapshot* baseline, Snapshot& out)
+{
+    using detail::SnapshotOp;
+    BitReader reader(data, size);
+    out.tick = reader.Read(32);
+    std::uint32_t baselineTick = reader.Read(32);
+    if (reader.Failed() || (baselineTick != NO_BASELINE && (!baseline || baseline->tick != baselineTick))) {
+        return false;
+    }
+
+    static const std::vector<EntityState> empty{};
+    const auto& base = baselineTick != NO_BASELINE ? baseline->entities : empty;
+    out.entities.clear();
+    out.entities.reserve(base.size());
+    Entity previous = 0;
+    bool first = true;
+    std::size_t j = 0;
+
+    for (;;) {
+        auto op = static_cast<SnapshotOp>(reader.Read(detail::SNAPSHOT_OP_BITS));
+        if (reader.Failed()) {
+            return false;
+        }
+        if (op == SnapshotOp::End) {
+            break;
+        }
+
+        Entity entity;
+        if (!detail::ReadEntityId(reader, entity, previous, first)) {
+            return false;
+        }
+        while (j < base.size() && base[j].entity < entity) {
+            out.entities.push_back(base[j++]);
+        }
+        bool inBase = j < base.size() && base[j].entity == entity;
+
+        switch (op) {
+            case SnapshotOp::Create: {
+                EntityState state;
+                state.entity = entity;
+                detail::ReadFullState(reader, state);
+                out.entities.push_back(state);
+                j += inBase ? 1 : 0;
+                break;
+            }
+            case SnapshotOp::Update: {
+                if (!inBase) {
+                    return false;
+                }
+                EntityState state = base[j++];
+                detail::ReadDeltaState(reader, state);
+                out.entities.push_back(state);
+                break;
+            }
+            case SnapshotOp::Remove:
+                if (!inBase) {
+                    return false;
+                }
+                ++j;
+                break;
+            case SnapshotOp::End:
+                break;
+        }
+    }
+
+    out.entities.insert(out.entities.end(), base.begin() + static_cast<std::ptrdiff_t>(j), base.end());
+    return !reader.Failed();
+}
+
+// Côté serveur : historique des snapshots envoyés à un client et dernier
+// tick acquitté, utilisé comme base du delta.
+class ClientReplication {
+public:
+    void Encode(const std::shared_ptr<const Snapshot>& snapshot, std::vector<std::uint8_t>& out)
+    {
+        WriteSnapshot(*snapshot, GetBaseline(snapshot->tick), out);
+        mSent[snapshot->tick % SNAPSHOT_BUFFER_SIZE] = snapshot;
+    }
+
+    void Acknowledge(std::uint32_t tick)
+    {
+        const auto& sent = mSent[tick % SNAPSHOT_BUFFER_SIZE];
+        if (!sent || sent->tick != tick) {
+            return;
+        }
+        if (!mHasAck || tick > mLastAckedTick) {
+            mLastAckedTick = tick;
+            mHasAck = true;
+        }
+    }
+
+    void Reset()
+    {
+        mSent.fill(nullptr);
+        mHasAck = false;
+    }
+
+    // Base utilisée pour encoder le snapshot du tick `tick`, si disponible.
+    const Snapshot* GetBaseline(std::uint32_t tick) const
+    {
+        if (!mHasAck || tick - mLastAckedTick >= SNAPSHOT_BUFFER_SIZE) {
+            return nullptr;
+        }
+        const auto& baseline = mSent[mLastAckedTick % SNAPSHOT_BUFFER_SIZE];
+        return baseline && baseline->tick == mLastAckedTick ? baseline.get() : nullptr;
+    }
+
+private:
+    std::array<std::shared_ptr<const Snapshot>, SNAPSHOT_BUFFER_SIZE> mSent{};
+    std::uint32_t mLastAckedTick{};
+    bool mHasAck{false};
+};
+
+// Côté client : historique des snapshots reçus pour décoder les deltas.
+class SnapshotReceiver {
+public:
+    // Retourne le snapshot décodé (à acquitter), ou nullptr si sa base est inconnue.
+    const Snapshot* Receive(const std::uint8_t* data, std::size_t size)
+    {
+        std::uint32_t tick = 0;
+        std::uint32_t baselineTick = 0;
+        if (!PeekSnapshotTicks(data, size, tick, baselineTick)) {
+            return nullptr;
+        }
+        if (mHasLatest && tick <= mLatestTick && tick + SNAPSHOT_BUFFER_SIZE > mLatestTick) {
+            return nullptr;
+        }
+
+        const Snapshot* baseline = nullptr;
+        if (baselineTick != NO_BASELINE) {
+            const Snapshot& candidate = mReceived[baselineTick % SNAPSHOT_BUFFER_SIZE];
+            if (!mValid[baselineTick % SNAPSHOT_BUFFER_SIZE] || candidate.tick != baselineTick) {
+                return nullptr;
+            }
+            baseline = &candidate;
+        }
+
+        Snapshot decoded;
+        if (!ReadSnapshot(data, size, baseline, decoded)) {
+            return nullptr;
+        }
+        std::size_t slot = tick % SNAPSHOT_BUFFER_SIZE;
+        mReceived[slot] = std::move(decoded);
+        mValid[slot] = true;
+        mLatestTick = tick;
+        mHasLatest = true;
+        return &mReceived[slot];
+    }
+
+    const Snapshot* Latest() const
+    {
+        return mHasLatest ? &mReceived[mLatestTick % SNAPSHOT_BUFFER_SIZE] : nullptr;
+    }
+
+private:
+    std::array<Snapshot, SNAPSHOT_BUFFER_SIZE> mReceived{};
+    std::array<bool, SNAPSHOT_BUFFER_SIZE> mValid{};
+    std::uint32_t mLatestTick{};
+    bool mHasLatest{false};
+};
+
+} // namespace ecs
@@ -0,0 +1,122 @@
+#include "behavior_io.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace ecs {
+
+namespace {
+
+const char* const STATE_NAMES[AI_STATE_COUNT] = {"idle", "patrolling", "chasing", "fleeing", "attacking"};
+
+bool ParseState(const std::string& name, std::size_t& state) {
+    for (std::size_t i = 0; i < AI_STATE_COUNT; ++i) {
+        if (name == STATE_NAMES[i]) {
+            state = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// "stop" | "drift vx vy" | "seek vitesse [vx vy]" | "flee vitesse [vx vy]"
+bool ParseAction(std::istringstream& words, StateAction& action) {
+    std::string motion;
+    words >> motion;
+    action = StateAction{};
+    if (motion == "stop") {
+        action.motion = Motion::Stop;
+        return true;
+    }
+    if (motion == "drift") {
+        action.motion = Motion::Drift;
+        return static_cast<bool>(words >> action.vx >> action.vy);
+    }
+    if (motion == "seek" || motion == "flee") {
+        action.motion = motion == "seek" ? Motion::Seek : Motion::Flee;
+        if (!(words >> action.speed)) {
+            return false;
+        }
+        if ((words >> std::ws).eof()) {
+            return true;
+        }
+        action.driftWithoutTarget = true;
+        return static_cast<bool>(words >> action.vx >> action.vy);
+    }
+    return false;
+}
+
+} // namespace
+
+bool ParseBehaviors(std::istream& in, BehaviorLibrary& library) {
+    std::vector<Behavior> parsed;
+    Behavior* current = nullptr;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string keyword;
+        if (!(words >> keyword)) {
+            continue;
+        }
+
+        bool valid = true;
+        if (keyword == "behavior") {
+            valid = !current;
+            parsed.push_back(DefaultBehavior());
+            current = &parsed.back();
+            valid = valid && static_cast<bool>(words >> current->name);
+        } else if (!current) {
+            valid = false;
+        } else if (keyword == "end") {
+            current = nullptr;
+        } else if (keyword == "detection") {
+            valid = static_cast<bool>(words >> current->detectionRange);
+        } else if (keyword == "attack") {
+            valid = static_cast<bool>(words >> current->attackRange);
+        } else if (keyword == "flee") {
+            valid = static_cast<bool>(words >> current->fleeHealthThreshold);
+        } else if (keyword == "cooldown") {
+            valid = static_cast<bool>(words >> current->decisionCooldown) && current->decisionCooldown > 0.f;
+        } else if (keyword == "state") {
+            std::string name;
+            std::size_t state = 0;
+            valid = static_cast<bool>(words >> name) && ParseState(name, state) &&
+                ParseAction(words, current->actions[state]);
+        } else {
+            valid = false;
+        }
+
+        std::string extra;
+        if (!valid || words >> extra) {
+            std::cerr << "Comportements : ligne " << number << " invalide : " << line << std::endl;
+            return false;
+        }
+    }
+    if (current) {
+        std::cerr << "Comportements : 'end' manquant pour " << current->name << std::endl;
+        return false;
+    }
+
+    if (library.Size() + parsed.size() > 256) {
+        std::cerr << "Comportements : plus de 256 comportements" << std::endl;
+        return false;
+    }
+    for (const Behavior& behavior : parsed) {
+        library.Add(behavior);
+    }
+    return true;
+}
+
+bool LoadBehaviorsFromFile(const std::string& path, BehaviorLibrary& library) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Impossible d'ouvrir " << path << std::endl;
+        return false;
+    }
+    return ParseBehaviors(file, library);
+}
+
+} // namespace ecs
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <istream>
+#include <string>
+
+#include "behavior.hpp"
+
+namespace ecs {
+
+// Format texte, une directive par ligne, '#' commente la fin de ligne :
+//
+//   behavior kamikaze
+//     detection 400          # portée de détection
+//     attack 10              # portée d'attaque
+//     flee 0                 # seuil de santé pour fuir (ratio)
+//     cooldown 0.5           # secondes entre deux décisions
+//     state idle stop
+//     state patrolling drift -80 0
+//     state chasing seek 260
+//     state fleeing flee 200 -100 0   # vitesse, puis dérive sans cible
+//     state attacking seek 300
+//   end
+//
+// Les états non décrits gardent l'action du comportement par défaut.
+// Un comportement déjà présent dans `library` (même nom) est remplacé.
+// En cas d'erreur, `library` n'est pas modifiée.
+bool ParseBehaviors(std::istream& in, BehaviorLibrary& library);
+
+bool LoadBehaviorsFromFile(const std::string& path, BehaviorLibrary& library);
+
+} // namespace ecs
@@ -0,0 +1,478 @@
+#include "replay.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "ecs.hpp"
+
+namespace ecs {
+
+namespace {
+
+constexpr std::uint32_t REPLAY_MAGIC = 0x50525452; // "RTRP"
+constexpr std::uint32_t REPLAY_VERSION = 3;
+// magic, version, tickDt, startTick, endTick, taille des réglages, taille du monde
+constexpr std::size_t REPLAY_HEADER_SIZE = 28;
+constexpr long REPLAY_END_TICK_OFFSET = 16;
+
+void WriteVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+template <typename T>
+void WriteRaw(std::vector<std::uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+bool ReadVarint(const std::vector<std::uint8_t>& data, std::size_t& offset, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= data.size()) {
+            return false;
+        }
+        std::uint8_t byte = data[offset++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool ReadRaw(const std::vector<std::uint8_t>& data, std::size_t& offset, T& value) {
+    if (sizeof(T) > data.size() - offset) {
+        return false;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+void WriteString(std::vector<std::uint8_t>& out, const std::string& text) {
+    WriteVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+bool ReadString(const std::vector<std::uint8_t>& data, std::size_t& offset, std::string& text) {
+    std::uint64_t size = 0;
+    if (!ReadVarint(data, offset, size) || size > data.size() - offset) {
+        return false;
+    }
+    text.assign(data.begin() + static_cast<std::ptrdiff_t>(offset),
+        data.begin() + static_cast<std::ptrdiff_t>(offset + size));
+    offset += size;
+    return true;
+}
+
+constexpr std::uint8_t SETTING_POOLING = 0x01;
+constexpr std::uint8_t SETTING_BALLISTIC = 0x02;
+
+void WriteBehavior(std::vector<std::uint8_t>& out, const Behavior& behavior) {
+    WriteString(out, behavior.name);
+    for (const StateAction& action : behavior.actions) {
+        out.push_back(static_cast<std::uint8_t>(action.motion));
+        WriteRaw(out, action.speed);
+        WriteRaw(out, action.vx);
+        WriteRaw(out, action.vy);
+        out.push_back(action.driftWithoutTarget ? 1 : 0);
+    }
+    WriteRaw(out, behavior.detectionRange);
+    WriteRaw(out, behavior.attackRange);
+    WriteRaw(out, behavior.fleeHealthThreshold);
+    WriteRaw(out, behavior.decisionCooldown);
+}
+
+// Mêmes contraintes que ParseBehaviors (behavior_io.hpp).
+bool ReadBehavior(const std::vector<std::uint8_t>& data, std::size_t& offset, Behavior& behavior) {
+    if (!ReadString(data, offset, behavior.name)) {
+        return false;
+    }
+    for (StateAction& action : behavior.actions) {
+        std::uint8_t motion = 0;
+        std::uint8_t drift = 0;
+        if (!ReadRaw(data, offset, motion) || !ReadRaw(data, offset, action.speed) ||
+            !ReadRaw(data, offset, action.vx) || !ReadRaw(data, offset, action.vy) ||
+            !ReadRaw(data, offset, drift) || motion > static_cast<std::uint8_t>(Motion::Flee)) {
+            return false;
+        }
+        action.motion = static_cast<Motion>(motion);
+        action.driftWithoutTarget = drift != 0;
+    }
+    return ReadRaw(data, offset, behavior.detectionRange) && ReadRaw(data, offset, behavior.attackRange) &&
+        ReadRaw(data, offset, behavior.fleeHealthThreshold) && ReadRaw(data, offset, behavior.decisionCooldown) &&
+        behavior.decisionCooldown > 0.f;
+}
+
+// Drapeaux, puis les tables de comportements et de patterns dans l'ordre
+// de leurs indices.
+std::vector<std::uint8_t> WriteSettings(const ReplaySettings& settings) {
+    std::vector<std::uint8_t> out;
+    out.push_back(static_cast<std::uint8_t>((settings.projectilePooling ? SETTING_POOLING : 0) |
+        (settings.ballisticProjectiles ? SETTING_BALLISTIC : 0)));
+    WriteVarint(out, settings.behaviors.Size());
+    for (std::size_t i = 0; i < settings.behaviors.Size(); ++i) {
+        WriteBehavior(out, settings.behaviors.Get(static_cast<std::uint8_t>(i)));
+    }
+    WriteVarint(out, settings.patterns.Size());
+    for (std::size_t i = 0; i < settings.patterns.Size(); ++i) {
+        const BulletPattern& pattern = settings.patterns.Get(static_cast<std::uint8_t>(i));
+        WriteString(out, pattern.name);
+        WriteVarint(out, static_cast<std::uint32_t>(pattern.count));
+        WriteRaw(out, pattern.spread);
+        WriteRaw(out, pattern.rotationRate);
+        WriteRaw(out, pattern.speedStep);
+        out.push_back(pattern.aimed ? 1 : 0);
+    }
+    return out;
+}
+
+bool ReadSettings(const std::vector<std::uint8_t>& data, ReplaySettings& settings) {
+    std::size_t offset = 0;
+    std::uint8_t flags = 0;
+    std::uint64_t behaviorCount = 0;
+    if (!ReadRaw(data, offset, flags) || !ReadVarint(data, offset, behaviorCount) ||
+        behaviorCount == 0 || behaviorCount > 256) {
+        return false;
+    }
+    settings = ReplaySettings{};
+    settings.projectilePooling = (flags & SETTING_POOLING) != 0;
+    settings.ballisticProjectiles = (flags & SETTING_BALLISTIC) != 0;
+    for (std::uint64_t i = 0; i < behaviorCount; ++i) {
+        Behavior behavior;
+        if (!ReadBehavior(data, offset, behavior) || settings.behaviors.Add(behavior) != i) {
+            return false;
+        }
+    }
+    std::uint64_t patternCount = 0;
+    if (!ReadVarint(data, offset, patternCount) || patternCount == 0 || patternCount > 256) {
+        return false;
+    }
+    for (std::uint64_t i = 0; i < patternCount; ++i) {
+        BulletPattern pattern;
+        std::uint64_t count = 0;
+        std::uint8_t aimed = 0;
+        if (!ReadString(data, offset, pattern.name) || !ReadVarint(data, offset, count) ||
+            !ReadRaw(data, offset, pattern.spread) || !ReadRaw(data, offset, pattern.rotationRate) ||
+            !ReadRaw(data, offset, pattern.speedStep) || !ReadRaw(data, offset, aimed) ||
+            count == 0 || count > 0x7fffffff) {
+            return false;
+        }
+        pattern.count = static_cast<int>(count);
+        pattern.aimed = aimed != 0;
+        // Noms uniques : Add() redonne à chaque pattern son indice.
+        if (settings.patterns.Add(pattern) != i) {
+            return false;
+        }
+    }
+    return offset == data.size();
+}
+
+// direction (1-9, pavé numérique) sur 4 bits, tir sur le bit 4.
+std::uint8_t PackInput(const PlayerInput& input) {
+    return static_cast<std::uint8_t>((input.direction & 0x0F) | (input.firePressed ? 0x10 : 0));
+}
+
+PlayerInput UnpackInput(std::uint8_t bits) {
+    PlayerInput input;
+    input.direction = bits & 0x0F;
+    input.firePressed = (bits & 0x10) != 0;
+    return input;
+}
+
+} // namespace
+
+ReplaySettings CaptureReplaySettings(const SystemRefs& systems) {
+    ReplaySettings settings;
+    settings.behaviors = systems.aiSystem->GetBehaviors();
+    settings.patterns = systems.spawnerSystem->GetPatterns();
+    settings.projectilePooling = systems.spawnerSystem->GetProjectilePooling();
+    settings.ballisticProjectiles = systems.spawnerSystem->GetBallisticProjectiles();
+    return settings;
+}
+
+void ApplyReplaySettings(const SystemRefs& systems, const ReplaySettings& settings) {
+    systems.aiSystem->SetBehaviors(settings.behaviors);
+    systems.spawnerSystem->SetPatterns(settings.patterns);
+    systems.spawnerSystem->SetProjectilePooling(settings.projectilePooling);
+    systems.spawnerSystem->SetBallisticProjectiles(settings.ballisticProjectiles);
+}
+
+ReplayRecorder::~ReplayRecorder() {
+    Close();
+}
+
+bool ReplayRecorder::Open(const std::string& path, float tickDt, std::uint32_t startTick,
+                          const ReplaySettings& settings) {
+    Close();
+
+    std::vector<std::uint8_t> world;
+    if (!gCoordinator.SaveWorld(world)) {
+        std::cerr << "Replay : le monde initial ne peut pas être sauvegardé." << std::endl;
+        return false;
+    }
+
+    mFile = std::fopen(path.c_str(), "wb");
+    if (!mFile) {
+        std::cerr << "Impossible d'ouvrir " << path << std::endl;
+        return false;
+    }
+    // Tampon large : une trame fait quelques octets, on évite un write par tick.
+    std::setvbuf(mFile, nullptr, _IOFBF, 1 << 16);
+
+    std::vector<std::uint8_t> header;
+    header.reserve(REPLAY_HEADER_SIZE);
+    WriteRaw(header, REPLAY_MAGIC);
+    WriteRaw(header, REPLAY_VERSION);
+    WriteRaw(header, tickDt);
+    WriteRaw(header, startTick);
+    WriteRaw(header, std::uint32_t{0}); // endTick, complété par Close()
+    std::vector<std::uint8_t> encoded = WriteSettings(settings);
+    WriteRaw(header, static_cast<std::uint32_t>(encoded.size()));
+    WriteRaw(header, static_cast<std::uint32_t>(world.size()));
+    mPath = path;
+    mFailed = false;
+    Write(header.data(), header.size());
+    Write(encoded.data(), encoded.size());
+    Write(world.data(), world.size());
+    if (mFailed) {
+        std::fclose(mFile);
+        mFile = nullptr;
+        std::cerr << "Replay : écriture impossible dans " << path << std::endl;
+        return false;
+    }
+
+    mTick = startTick;
+    mLastFrameTick = startTick;
+    mEventCount = 0;
+    mEvents.clear();
+    mLastInputs.assign(MAX_ENTITIES, PlayerInput{});
+    mHasInput.assign(MAX_ENTITIES, false);
+    return true;
+}
+
+bool ReplayRecorder::Close() {
+    if (!mFile) {
+        return !mFailed;
+    }
+    mEvents.clear();
+    mEventCount = 0;
+    // Trame vide = fin du journal.
+    WriteFrame(mTick - mLastFrameTick, {}, 0);
+    if (std::fseek(mFile, REPLAY_END_TICK_OFFSET, SEEK_SET) != 0) {
+        mFailed = true;
+    }
+    Write(&mTick, sizeof(mTick));
+    if (std::fclose(mFile) != 0) {
+        mFailed = true;
+    }
+    mFile = nullptr;
+    if (mFailed) {
+        std::cerr << "Replay : écriture incomplète de " << mPath << std::endl;
+    }
+    return !mFailed;
+}
+
+void ReplayRecorder::RecordInput(Entity entity, const PlayerInput& input) {
+    if (!mFile || entity >= MAX_ENTITIES) {
+        return;
+    }
+    std::uint8_t bits = PackInput(input);
+    if (mHasInput[entity] && PackInput(mLastInputs[entity]) == bits) {
+        return;
+    }
+    mLastInputs[entity] = input;
+    mHasInput[entity] = true;
+
+    mEvents.push_back(static_cast<std::uint8_t>(ReplayEvent::Type::Input));
+    WriteVarint(mEvents, entity);
+    mEvents.push_back(bits);
+    ++mEventCount;
+}
+
+void ReplayRecorder::RecordSeed(std::uint64_t seed) {
+    if (!mFile) {
+        return;
+    }
+    mEvents.push_back(static_cast<std::uint8_t>(ReplayEvent::Type::Seed));
+    WriteRaw(mEvents, seed);
+    ++mEventCount;
+}
+
+void ReplayRecorder::RecordSpawn(std::uint8_t kind, float x, float y, std::uint32_t param) {
+    if (!mFile) {
+        return;
+    }
+    mEvents.push_back(static_cast<std::uint8_t>(ReplayEvent::Type::Spawn));
+    mEvents.push_back(kind);
+    WriteRaw(mEvents, x);
+    WriteRaw(mEvents, y);
+    WriteVarint(mEvents, param);
+    ++mEventCount;
+}
+
+void ReplayRecorder::EndTick() {
+    if (!mFile) {
+        return;
+    }
+    if (mEventCount > 0) {
+        WriteFrame(mTick - mLastFrameTick, mEvents, mEventCount);
+        mLastFrameTick = mTick;
+        mEvents.clear();
+        mEventCount = 0;
+    }
+    ++mTick;
+}
+
+void ReplayRecorder::WriteFrame(std::uint32_t tickDelta, const std::vector<std::uint8_t>& events, std::uint32_t count) {
+    std::vector<std::uint8_t> frame;
+    frame.reserve(10 + events.size());
+    WriteVarint(frame, tickDelta);
+    WriteVarint(frame, count);
+    frame.insert(frame.end(), events.begin(), events.end());
+    Write(frame.data(), frame.size());
+}
+
+void ReplayRecorder::Write(const void* data, std::size_t size) {
+    if (!mFailed && std::fwrite(data, 1, size, mFile) != size) {
+        mFailed = true;
+    }
+}
+
+bool ReplayPlayer::Open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Impossible d'ouvrir " << path << std::endl;
+        return false;
+    }
+    mData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    mOffset = 0;
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t settingsSize = 0;
+    std::uint32_t worldSize = 0;
+    if (!ReadRaw(mData, mOffset, magic) || !ReadRaw(mData, mOffset, version) ||
+        !ReadRaw(mData, mOffset, mTickDt) || !ReadRaw(mData, mOffset, mTick) ||
+        !ReadRaw(mData, mOffset, mEndTick) || !ReadRaw(mData, mOffset, settingsSize) ||
+        !ReadRaw(mData, mOffset, worldSize) || magic != REPLAY_MAGIC || version != REPLAY_VERSION ||
+        settingsSize > mData.size() - mOffset || worldSize > mData.size() - mOffset - settingsSize) {
+        std::cerr << "Journal de replay invalide : " << path << std::endl;
+        return false;
+    }
+    std::vector<std::uint8_t> settings(mData.begin() + static_cast<std::ptrdiff_t>(mOffset),
+        mData.begin() + static_cast<std::ptrdiff_t>(mOffset + settingsSize));
+    if (!ReadSettings(settings, mSettings)) {
+        std::cerr << "Réglages du replay invalides : " << path << std::endl;
+        return false;
+    }
+    mOffset += settingsSize;
+    if (!gCoordinator.LoadWorld(mData.data() + mOffset, worldSize)) {
+        std::cerr << "Monde initial du replay incompatible : " << path << std::endl;
+        return false;
+    }
+    mOffset += worldSize;
+    mNextFrameTick = mTick;
+    mHasFrame = ReadFrameHeader();
+    return true;
+}
+
+bool ReplayPlayer::ReadFrameHeader() {
+    std::uint64_t delta = 0;
+    std::uint64_t count = 0;
+    if (!ReadVarint(mData, mOffset, delta) || !ReadVarint(mData, mOffset, count)) {
+        return false;
+    }
+    mNextFrameTick += static_cast<std::uint32_t>(delta);
+    mNextFrameCount = static_cast<std::uint32_t>(count);
+    if (count == 0) {
+        mEndTick = mNextFrameTick;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayPlayer::NextTick(std::vector<ReplayEvent>& events) {
+    events.clear();
+    if (!mHasFrame && mTick >= mEndTick) {
+        return false;
+    }
+    if (mHasFrame && mNextFrameTick == mTick) {
+        for (std::uint32_t i = 0; i < mNextFrameCount; ++i) {
+            ReplayEvent event;
+            std::uint8_t type = 0;
+            bool ok = ReadRaw(mData, mOffset, type);
+            event.type = static_cast<ReplayEvent::Type>(type);
+            if (ok && event.type == ReplayEvent::Type::Input) {
+                std::uint64_t entity = 0;
+                std::uint8_t bits = 0;
+                ok = ReadVarint(mData, mOffset, entity) && ReadRaw(mData, mOffset, bits);
+                event.entity = static_cast<Entity>(entity);
+                event.input = UnpackInput(bits);
+            } else if (ok && event.type == ReplayEvent::Type::Seed) {
+                ok = ReadRaw(mData, mOffset, event.seed);
+            } else if (ok && event.type == ReplayEvent::Type::Spawn) {
+                std::uint64_t param = 0;
+                ok = ReadRaw(mData, mOffset, event.spawnKind) && ReadRaw(mData, mOffset, event.x) &&
+                    ReadRaw(mData, mOffset, event.y) && ReadVarint(mData, mOffset, param);
+                event.param = static_cast<std::uint32_t>(param);
+            } else {
+                ok = false;
+            }
+            if (!ok) {
+                // Journal tronqué : on s'arrête au dernier tick complet.
+                mHasFrame = false;
+                mEndTick = mTick;
+                events.clear();
+                return false;
+            }
+            events.push_back(event);
+        }
+        mHasFrame = ReadFrameHeader();
+    }
+    ++mTick;
+    return true;
+}
+
+void ApplyReplayInput(const ReplayEvent& event) {
+    if (event.type != ReplayEvent::Type::Input || event.entity >= MAX_ENTITIES ||
+        !gCoordinator.HasComponent<PlayerInput>(event.entity)) {
+        return;
+    }
+    gCoordinator.WriteComponent<PlayerInput>(event.entity) = event.input;
+}
+
+bool ApplyReplayEvent(const ReplayEvent& event, const ReplayHooks& hooks) {
+    switch (event.type) {
+        case ReplayEvent::Type::Input:
+            ApplyReplayInput(event);
+            return true;
+        case ReplayEvent::Type::Spawn:
+            if (!hooks.spawn) {
+                std::cerr << "Replay : spawn externe sans fonction de spawn." << std::endl;
+                return false;
+            }
+            if (!hooks.spawn(event)) {
+                std::cerr << "Replay : spawn externe de type " << static_cast<int>(event.spawnKind)
+                          << " impossible." << std::endl;
+                return false;
+            }
+            return true;
+        case ReplayEvent::Type::Seed:
+            if (!hooks.seed || !hooks.seed(event.seed)) {
+                std::cerr << "Replay : graine " << event.seed << " sans générateur à réinitialiser." << std::endl;
+                return false;
+            }
+            return true;
+    }
+    return false;
+}
+
+} // namespace ecs
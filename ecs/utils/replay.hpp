@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "behavior.hpp"
+#include "bullet_pattern.hpp"
+#include "components.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+namespace ecs {
+
+// Evénement externe à la simulation, rejoué au tick où il a été enregistré.
+struct ReplayEvent {
+    enum class Type : std::uint8_t {
+        Input,
+        Seed,
+        Spawn
+    };
+
+    Type type{Type::Input};
+    Entity entity{MAX_ENTITIES};
+    PlayerInput input{};
+    std::uint64_t seed{};
+    std::uint8_t spawnKind{};
+    float x{};
+    float y{};
+    std::uint32_t param{};
+};
+
+// Réglages des systèmes qui ne font pas partie du monde sauvegardé mais
+// changent la simulation : le replay doit tourner avec les mêmes.
+struct ReplaySettings {
+    BehaviorLibrary behaviors{};
+    PatternLibrary patterns{};
+    bool projectilePooling{true};
+    bool ballisticProjectiles{true};
+};
+
+// Réglages actuels des systèmes, à passer à ReplayRecorder::Open().
+ReplaySettings CaptureReplaySettings(const SystemRefs& systems);
+
+// Applique aux systèmes les réglages lus par ReplayPlayer::Open().
+void ApplyReplaySettings(const SystemRefs& systems, const ReplaySettings& settings);
+
+// Journal binaire en flux : en-tête, réglages, monde initial (SaveWorld),
+// puis une trame par tick ayant des événements (delta de tick en varint).
+//
+// Seuls les changements de PlayerInput sont écrits ; tout le reste de la
+// simulation est déterministe et recalculé au replay.
+class ReplayRecorder {
+public:
+    ReplayRecorder() = default;
+    ~ReplayRecorder();
+
+    // Sauvegarde gCoordinator comme état initial ; à appeler entre deux ticks.
+    bool Open(const std::string& path, float tickDt, std::uint32_t startTick, const ReplaySettings& settings);
+
+    // Le journal couvre les ticks clos par EndTick() : les événements d'un
+    // tick non clos sont abandonnés. Faux si une écriture a échoué.
+    bool Close();
+
+    void RecordInput(Entity entity, const PlayerInput& input);
+    void RecordSeed(std::uint64_t seed);
+    void RecordSpawn(std::uint8_t kind, float x, float y, std::uint32_t param);
+
+    // Clôt le tick courant (écrit sa trame s'il y a eu des événements).
+    void EndTick();
+
+private:
+    void WriteFrame(std::uint32_t tickDelta, const std::vector<std::uint8_t>& events, std::uint32_t count);
+    void Write(const void* data, std::size_t size);
+
+    std::FILE* mFile{nullptr};
+    std::string mPath{};
+    bool mFailed{false};
+    std::uint32_t mTick{};
+    std::uint32_t mLastFrameTick{};
+    std::uint32_t mEventCount{};
+    std::vector<std::uint8_t> mEvents{};
+    std::vector<PlayerInput> mLastInputs{};
+    std::vector<bool> mHasInput{};
+};
+
+// Relit un journal : charge le monde initial dans gCoordinator puis
+// fournit les événements tick par tick. Les réglages enregistrés sont à
+// appliquer (ApplyReplaySettings) avant le premier tick.
+class ReplayPlayer {
+public:
+    bool Open(const std::string& path);
+
+    const ReplaySettings& GetSettings() const { return mSettings; }
+
+    // Evénements du prochain tick ; faux quand le journal est terminé.
+    bool NextTick(std::vector<ReplayEvent>& events);
+
+    float GetTickDt() const { return mTickDt; }
+    std::uint32_t GetTick() const { return mTick; }
+    std::uint32_t GetEndTick() const { return mEndTick; }
+
+private:
+    bool ReadFrameHeader();
+
+    std::vector<std::uint8_t> mData{};
+    std::size_t mOffset{};
+    ReplaySettings mSettings{};
+    float mTickDt{};
+    std::uint32_t mTick{};
+    std::uint32_t mNextFrameTick{};
+    std::uint32_t mNextFrameCount{};
+    std::uint32_t mEndTick{};
+    bool mHasFrame{false};
+};
+
+// Applique un événement d'input (les autres types sont laissés à l'appelant).
+void ApplyReplayInput(const ReplayEvent& event);
+
+// Spawn et Seed sont propres au jeu : le replay les confie à ces
+// fonctions. Une fonction absente ou qui échoue arrête le replay, qui
+// divergerait sinon de la partie enregistrée.
+struct ReplayHooks {
+    std::function<bool(const ReplayEvent&)> spawn;
+    std::function<bool(std::uint64_t)> seed;
+};
+
+// Applique un événement de tick, avant StepECS. Faux (message sur
+// std::cerr) s'il ne peut pas l'être.
+bool ApplyReplayEvent(const ReplayEvent& event, const ReplayHooks& hooks);
+
+} // namespace ecs
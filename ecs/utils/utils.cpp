@@ -2,9 +2,9 @@
 
 namespace ecs {
 
-SystemRefs InitECS() {
+SystemRefs InitECS(const MemoryPolicy& memory) {
     SystemRefs systems;
-    gCoordinator.Init();
+    gCoordinator.Init(memory);
 
     gCoordinator.RegisterComponent<Transform>();
     gCoordinator.RegisterComponent<Velocity>();
@@ -18,6 +18,8 @@ SystemRefs InitECS() {
     gCoordinator.RegisterComponent<Damager>();
     gCoordinator.RegisterComponent<AIController>();
     gCoordinator.RegisterComponent<Spawner>();
+    gCoordinator.RegisterComponent<NetworkId>();
+    gCoordinator.RegisterComponent<Ballistic>();
 
     // Input System
     systems.inputSystem = gCoordinator.RegisterSystem<InputSystem>();
@@ -38,6 +40,11 @@ SystemRefs InitECS() {
         signature.set(gCoordinator.GetComponentType<Team>());
         signature.set(gCoordinator.GetComponentType<Health>());
         gCoordinator.SetSystemSignature<AISystem>(signature);
+        // Cibles disparues oubliées par lot au point de synchronisation
+        // (ProcessDestructions), plutôt que revérifiées à chaque tick.
+        gCoordinator.OnMatch(signature, nullptr, [ai = systems.aiSystem](const std::vector<Entity>& removed) {
+            ai->ForgetTargets(removed);
+        });
     }
 
     // Movement System
@@ -49,7 +56,8 @@ SystemRefs InitECS() {
         gCoordinator.SetSystemSignature<MovementSystem>(signature);
     }
 
-    // Collision System (détection + résolution)
+    // Collision System (détection continue ; projectiles compris, seule la
+    // cible d'un coup a besoin d'une Health)
     systems.collisionSystem = gCoordinator.RegisterSystem<CollisionSystem>();
     {
         Signature signature;
@@ -57,10 +65,17 @@ SystemRefs InitECS() {
         signature.set(gCoordinator.GetComponentType<Collider>());
         signature.set(gCoordinator.GetComponentType<Team>());
         signature.set(gCoordinator.GetComponentType<Damager>());
-        signature.set(gCoordinator.GetComponentType<Health>());
         gCoordinator.SetSystemSignature<CollisionSystem>(signature);
     }
 
+    // Damage System (applique les DamageEvent de la collision)
+    systems.damageSystem = gCoordinator.RegisterSystem<DamageSystem>();
+    {
+        Signature signature;
+        signature.set(gCoordinator.GetComponentType<Health>());
+        gCoordinator.SetSystemSignature<DamageSystem>(signature);
+    }
+
     // Spawner System
     systems.spawnerSystem = gCoordinator.RegisterSystem<SpawnerSystem>();
     {
@@ -96,7 +111,52 @@ SystemRefs InitECS() {
         gCoordinator.SetSystemSignature<BoundarySystem>(signature);
     }
 
+    // Ballistic System (sortie d'écran des projectiles balistiques)
+    systems.ballisticSystem = gCoordinator.RegisterSystem<BallisticSystem>();
+    {
+        Signature signature;
+        signature.set(gCoordinator.GetComponentType<Transform>());
+        signature.set(gCoordinator.GetComponentType<Ballistic>());
+        gCoordinator.SetSystemSignature<BallisticSystem>(signature);
+    }
+
+    // Snapshot System (réplication réseau)
+    systems.snapshotSystem = gCoordinator.RegisterSystem<SnapshotSystem>();
+    {
+        Signature signature;
+        signature.set(gCoordinator.GetComponentType<Transform>());
+        gCoordinator.SetSystemSignature<SnapshotSystem>(signature);
+    }
+
+    // Lag Compensation System (historique des colliders des cibles : sans
+    // Health, un projectile ne peut pas être la cible d'un tir)
+    systems.lagCompensationSystem = gCoordinator.RegisterSystem<LagCompensationSystem>();
+    {
+        Signature signature;
+        signature.set(gCoordinator.GetComponentType<Transform>());
+        signature.set(gCoordinator.GetComponentType<Collider>());
+        signature.set(gCoordinator.GetComponentType<Team>());
+        signature.set(gCoordinator.GetComponentType<Health>());
+        gCoordinator.SetSystemSignature<LagCompensationSystem>(signature);
+    }
+
     return systems;
 }
 
+void StepECS(const SystemRefs& systems, float dt) {
+    gCoordinator.AdvanceChangeTick();
+    gCoordinator.AdvanceTick();
+    systems.inputSystem->Update();
+    systems.aiSystem->Update(dt);
+    systems.movementSystem->Update(dt);
+    systems.collisionSystem->Update(dt);
+    systems.damageSystem->Update();
+    systems.spawnerSystem->Update(dt);
+    systems.healthSystem->Update(dt);
+    systems.lifetimeSystem->Update(dt);
+    systems.boundarySystem->Update();
+    systems.ballisticSystem->Update();
+    gCoordinator.ProcessDestructions();
+}
+
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "ecs.hpp"
 #include "components.hpp"
 #include "systems.hpp"
+#include "snapshot.hpp"
+#include "lag_compensation.hpp"
 #include <memory>
 
 namespace ecs {
@@ -13,13 +15,24 @@ struct SystemRefs {
     std::shared_ptr<AISystem> aiSystem;
     std::shared_ptr<MovementSystem> movementSystem;
     std::shared_ptr<CollisionSystem> collisionSystem;
+    std::shared_ptr<DamageSystem> damageSystem;
     std::shared_ptr<SpawnerSystem> spawnerSystem;
     std::shared_ptr<HealthSystem> healthSystem;
     std::shared_ptr<LifetimeSystem> lifetimeSystem;
     std::shared_ptr<BoundarySystem> boundarySystem;
+    std::shared_ptr<BallisticSystem> ballisticSystem;
+    std::shared_ptr<SnapshotSystem> snapshotSystem;
+    std::shared_ptr<LagCompensationSystem> lagCompensationSystem;
 };
 
-// Initialise tout l'ECS : Coordinator, Composants et Systèmes
-SystemRefs InitECS();
+// Initialise tout l'ECS : Coordinator, Composants et Systèmes.
+// `memory` : placement des composants (huge pages, nœud NUMA) pour un
+// serveur dédié ; à appeler depuis le thread qui fera tourner le monde.
+SystemRefs InitECS(const MemoryPolicy& memory = {});
+
+// Exécute un tick de simulation, systèmes dans l'ordre canonique
+// (identique sur le serveur, en replay et dans les benchmarks).
+// Ouvre aussi un nouveau tick de suivi des modifications.
+void StepECS(const SystemRefs& systems, float dt);
 
 } // namespace ecs
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "world_io.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "ecs.hpp"
+
+namespace ecs {
+
+bool SaveWorldToFile(const std::string& path) {
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(1 << 20);
+    if (!gCoordinator.SaveWorld(buffer)) {
+        std::cerr << "Sauvegarde impossible : composant non trivialement copiable." << std::endl;
+        return false;
+    }
+
+    std::string tmpPath = path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Impossible d'ouvrir " << tmpPath << std::endl;
+        return false;
+    }
+
+    std::size_t written = 0;
+    while (written < buffer.size()) {
+        ssize_t n = write(fd, buffer.data() + written, buffer.size() - written);
+        if (n <= 0) {
+            std::cerr << "Erreur d'écriture dans " << tmpPath << std::endl;
+            close(fd);
+            unlink(tmpPath.c_str());
+            return false;
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    close(fd);
+
+    // Renommage atomique : un checkpoint n'est jamais à moitié écrit.
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LoadWorldFromFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Impossible d'ouvrir " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "mmap a échoué pour " << path << std::endl;
+        return false;
+    }
+    madvise(mapped, size, MADV_SEQUENTIAL);
+
+    bool loaded = gCoordinator.LoadWorld(static_cast<const std::uint8_t*>(mapped), size);
+    munmap(mapped, size);
+    if (!loaded) {
+        std::cerr << "Fichier de monde invalide : " << path << std::endl;
+    }
+    return loaded;
+}
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+namespace ecs {
+
+// Sauvegarde gCoordinator dans un fichier en une seule écriture.
+bool SaveWorldToFile(const std::string& path);
+
+// Recharge gCoordinator depuis un fichier projeté en mémoire (mmap).
+// InitECS() doit avoir été appelé : l'ordre d'enregistrement des
+// composants doit être identique à celui de la sauvegarde.
+bool LoadWorldFromFile(const std::string& path);
+
+} // namespace ecs
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Protocole binaire R-Type.
+//
+// Chaque datagramme commence par un en-tête fixe de HEADER_SIZE octets,
+// tous les champs multi-octets sont en little-endian :
+//
+//   octet 0      : [7..4] flags | [3..0] version
+//   octet 1      : type (PacketType)
+//   octets 2-3   : sequence
+//   octets 4-5   : ack (dernière séquence reçue du pair)
+//   octets 6-9   : ackBits (bit n = séquence ack - 1 - n reçue)
+//   octets 10-11 : longueur du payload
+//
+// Le payload suit directement l'en-tête, sans délimiteur.
+
+inline constexpr std::uint8_t PROTOCOL_VERSION = 1;
+inline constexpr std::size_t HEADER_SIZE = 12;
+inline constexpr std::size_t MAX_PACKET_SIZE = 1200;
+inline constexpr std::size_t MAX_PAYLOAD_SIZE = MAX_PACKET_SIZE - HEADER_SIZE;
+
+enum class PacketType : std::uint8_t {
+    Connect,
+    ConnectAck,
+    Disconnect,
+    Ping,
+    Pong,
+    Input,
+    Snapshot,
+    Message,
+    Ack,
+    Count
+};
+
+// Bits du champ flags de l'en-tête.
+inline constexpr std::uint8_t PACKET_FLAG_RELIABLE = 1 << 0;
+inline constexpr std::uint8_t PACKET_FLAG_HAS_ACK = 1 << 1;
+
+struct PacketHeader {
+    std::uint8_t version{PROTOCOL_VERSION};
+    std::uint8_t flags{};
+    PacketType type{PacketType::Message};
+    std::uint16_t sequence{};
+    std::uint16_t ack{};
+    std::uint32_t ackBits{};
+    std::uint16_t payloadSize{};
+};
+
+// Lecture/écriture little-endian indépendante de l'architecture hôte.
+inline void writeU16(std::uint8_t *dst, std::uint16_t value)
+{
+    dst[0] = static_cast<std::uint8_t>(value);
+    dst[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+inline void writeU32(std::uint8_t *dst, std::uint32_t value)
+{
+    dst[0] = static_cast<std::uint8_t>(value);
+    dst[1] = static_cast<std::uint8_t>(value >> 8);
+    dst[2] = static_cast<std::uint8_t>(value >> 16);
+    dst[3] = static_cast<std::uint8_t>(value >> 24);
+}
+
+inline std::uint16_t readU16(const std::uint8_t *src)
+{
+    return static_cast<std::uint16_t>(src[0] | (src[1] << 8));
+}
+
+inline std::uint32_t readU32(const std::uint8_t *src)
+{
+    return static_cast<std::uint32_t>(src[0])
+        | (static_cast<std::uint32_t>(src[1]) << 8)
+        | (static_cast<std::uint32_t>(src[2]) << 16)
+        | (static_cast<std::uint32_t>(src[3]) << 24);
+}
+
+void encodeHeader(const PacketHeader &header, std::uint8_t *dst);
+bool decodeHeader(const std::uint8_t *src, std::size_t size, PacketHeader &header);
+
+// Buffer de taille fixe (un datagramme), recyclé par BufferPool.
+struct PacketBuffer {
+    std::array<std::uint8_t, MAX_PACKET_SIZE> data{};
+    std::size_t size{};
+};
+
+// Pool de PacketBuffer pré-alloués : aucune allocation par paquet.
+class BufferPool {
+public:
+    struct Releaser {
+        BufferPool *pool{};
+        void operator()(PacketBuffer *buffer) const;
+    };
+    using Handle = std::unique_ptr<PacketBuffer, Releaser>;
+
+    explicit BufferPool(std::size_t capacity = 64);
+    ~BufferPool() = default;
+
+    Handle acquire();
+    std::size_t available();
+
+private:
+    void release(PacketBuffer *buffer);
+
+    std::vector<std::unique_ptr<PacketBuffer>> _storage;
+    std::vector<PacketBuffer *> _free;
+    std::mutex _poolMutex;
+};
+
+// Sérialise un paquet directement dans un PacketBuffer.
+class PacketWriter {
+public:
+    PacketWriter(PacketBuffer &buffer, const PacketHeader &header);
+
+    bool writeU8(std::uint8_t value);
+    bool writeU16(std::uint16_t value);
+    bool writeU32(std::uint32_t value);
+    bool writeF32(float value);
+    bool writeBytes(const void *data, std::size_t size);
+
+    // Ecrit l'en-tête final (longueur du payload) et fixe buffer.size.
+    std::size_t finish();
+    bool overflow() const;
+
+private:
+    PacketBuffer &_buffer;
+    PacketHeader _header;
+    std::size_t _offset;
+    bool _overflow;
+};
+
+// Lit un paquet sans copie : le payload reste dans le buffer d'origine.
+class PacketReader {
+public:
+    PacketReader(const std::uint8_t *data, std::size_t size);
+
+    bool valid() const;
+    const PacketHeader &header() const;
+    const std::uint8_t *payload() const;
+    std::size_t remaining() const;
+
+    bool readU8(std::uint8_t &value);
+    bool readU16(std::uint16_t &value);
+    bool readU32(std::uint32_t &value);
+    bool readF32(float &value);
+    bool readBytes(void *dst, std::size_t size);
+    bool skip(std::size_t size);
+
+private:
+    const std::uint8_t *_payload;
+    PacketHeader _header;
+    std::size_t _offset;
+    bool _valid;
+};
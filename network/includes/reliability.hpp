@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "packet.hpp"
+
+// Canal logique d'un message : les snapshots de jeu passent en Unreliable
+// et ne sont jamais bloqués par les messages de lobby en ReliableOrdered.
+enum class Channel : std::uint8_t {
+    Unreliable,
+    ReliableOrdered
+};
+
+struct NetMessage {
+    PacketType type{PacketType::Message};
+    Channel channel{Channel::Unreliable};
+    std::vector<std::uint8_t> payload;
+};
+
+// Retourne vrai si la séquence a est plus récente que b (avec rebouclage).
+inline bool sequenceGreater(std::uint16_t a, std::uint16_t b)
+{
+    return ((a > b) && (a - b <= 32768)) || ((a < b) && (b - a > 32768));
+}
+
+// Couche de fiabilité au-dessus d'UDP, indépendante du socket.
+//
+// Chaque paquet sortant porte une séquence et acquitte les 33 derniers
+// paquets reçus (ack + ackBits). Les messages fiables sont retransmis
+// individuellement quand le paquet qui les portait n'est pas acquitté
+// avant le RTO, calculé à partir du RTT mesuré (RFC 6298), et sont
+// délivrés dans l'ordre côté réception. Le RTO double à chaque expiration
+// et n'est recalculé qu'à partir d'un paquet jamais retransmis.
+class ReliableEndpoint {
+public:
+    using Clock = std::chrono::steady_clock;
+    using SendFunction = std::function<void(const PacketBuffer &)>;
+
+    explicit ReliableEndpoint(SendFunction send);
+    ~ReliableEndpoint() = default;
+
+    bool send(PacketType type, const std::uint8_t *data, std::size_t size,
+        Channel channel, Clock::time_point now = Clock::now());
+    bool receive(const std::uint8_t *data, std::size_t size, Clock::time_point now = Clock::now());
+
+    // Retransmet les messages expirés et envoie un ack seul si nécessaire.
+    void update(Clock::time_point now = Clock::now());
+
+    bool poll(NetMessage &message);
+
+    Clock::duration getRtt() const;
+    Clock::duration getRto() const;
+    std::size_t getPendingReliable() const;
+    std::uint64_t getRetransmitCount() const;
+
+private:
+    struct SentPacket {
+        std::uint16_t sequence{};
+        Clock::time_point sentAt{};
+        std::uint16_t messageId{};
+        bool reliable{false};
+        bool retransmission{false};
+        bool valid{false};
+    };
+
+    struct PendingMessage {
+        std::uint16_t id{};
+        PacketType type{PacketType::Message};
+        std::vector<std::uint8_t> payload;
+        Clock::time_point lastSent{};
+    };
+
+    static constexpr std::size_t SENT_BUFFER_SIZE = 1024;
+
+    bool transmit(PacketType type, std::uint8_t flags, const std::uint8_t *prefix,
+        std::size_t prefixSize, const std::uint8_t *data, std::size_t size,
+        Clock::time_point now, std::uint16_t messageId, bool retransmission = false);
+    bool markReceived(std::uint16_t sequence);
+    void processAcks(std::uint16_t ack, std::uint32_t ackBits, Clock::time_point now);
+    void onPacketAcked(std::uint16_t sequence, Clock::time_point now);
+    void updateRtt(Clock::duration sample);
+    void deliverReliable(std::uint16_t id, PacketType type, const std::uint8_t *data, std::size_t size);
+
+    SendFunction _send;
+    BufferPool _pool;
+
+    std::uint16_t _localSequence;
+    std::array<SentPacket, SENT_BUFFER_SIZE> _sent;
+
+    std::uint16_t _remoteSequence;
+    std::uint32_t _remoteBits;
+    bool _hasRemote;
+    bool _ackPending;
+
+    std::uint16_t _nextMessageId;
+    std::deque<PendingMessage> _pending;
+    std::uint16_t _nextExpectedId;
+    std::map<std::uint16_t, NetMessage> _outOfOrder;
+    std::deque<NetMessage> _inbox;
+
+    bool _hasRtt;
+    Clock::duration _srtt;
+    Clock::duration _rttVar;
+    Clock::duration _rto;
+    std::uint64_t _retransmits;
+};
+
+// Simule un lien perdant/retardé entre deux endpoints dans le même processus.
+class LossyLink {
+public:
+    using Clock = ReliableEndpoint::Clock;
+
+    LossyLink(float lossRate, Clock::duration delay, Clock::duration jitter, std::uint32_t seed = 1);
+    ~LossyLink() = default;
+
+    ReliableEndpoint::SendFunction input();
+    void setOutput(ReliableEndpoint *destination);
+    void update(Clock::time_point now = Clock::now());
+
+    std::uint64_t getDropped() const;
+
+private:
+    struct InFlight {
+        Clock::time_point deliverAt;
+        std::vector<std::uint8_t> data;
+    };
+
+    std::uint32_t nextRandom();
+
+    float _lossRate;
+    Clock::duration _delay;
+    Clock::duration _jitter;
+    std::uint32_t _state;
+    ReliableEndpoint *_destination;
+    Clock::time_point _now;
+    std::vector<InFlight> _inFlight;
+    std::uint64_t _dropped;
+};
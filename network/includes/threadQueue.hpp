@@ -1,22 +1,64 @@
 #pragma once
-#include <queue>
+#include <cstddef>
 #include <mutex>
 #include <string>
-#include <iostream>
-
-
+#include <utility>
+#include <vector>
 
+// File FIFO protégée par un mutex, entre le thread réseau et le jeu.
+//
+// Tampon circulaire qui ne rétrécit jamais : une fois sa capacité
+// atteinte, push et try_pop n'allouent plus rien eux-mêmes. Avec
+// T = BufferPool::Handle, un paquet traverse la file sans aucune copie
+// ni allocation ; le buffer retourne au pool quand le dernier Handle
+// est détruit.
+template <typename T = std::string>
 class ThQueue {
 public:
-    ThQueue() = default;
+    explicit ThQueue(std::size_t capacity = 64) : _items(capacity > 0 ? capacity : 1) {}
     ~ThQueue() = default;
 
-    void push(const std::string value);
-    bool try_pop(std::string &result);
-    bool empty();
+    void push(T value)
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        if (_count == _items.size()) {
+            grow();
+        }
+        _items[(_head + _count) % _items.size()] = std::move(value);
+        ++_count;
+    }
+
+    bool try_pop(T &result)
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        if (_count == 0) {
+            return false;
+        }
+        result = std::move(_items[_head]);
+        _head = (_head + 1) % _items.size();
+        --_count;
+        return true;
+    }
+
+    bool empty()
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        return _count == 0;
+    }
 
-private :
-    std::queue<std::string> _queue;
-    std::mutex  _queueMutex; 
+private:
+    void grow()
+    {
+        std::vector<T> bigger(_items.size() * 2);
+        for (std::size_t i = 0; i < _count; ++i) {
+            bigger[i] = std::move(_items[(_head + i) % _items.size()]);
+        }
+        _items.swap(bigger);
+        _head = 0;
+    }
 
-};
\ No newline at end of file
+    std::vector<T> _items;
+    std::size_t _head{0};
+    std::size_t _count{0};
+    std::mutex _queueMutex;
+};
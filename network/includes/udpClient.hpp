@@ -12,7 +12,9 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 
-class ThQueue;
+#include "packet.hpp"
+#include "reliability.hpp"
+#include "threadQueue.hpp"
 
 class UdpClient {
 public:
@@ -23,18 +25,26 @@ public:
     void disconnect();
 
     bool sendData(const std::string& data);
-    std::string receiveData(int bufferSize = 1024);
+    // Paquet reçu, lu en place (PacketReader) ; nul si rien n'est arrivé.
+    BufferPool::Handle receiveData();
 
-    std::string waiter(std::string expect, std::string to_send, int i = 0);
+    bool sendPacket(const PacketBuffer& packet);
+    bool receivePacket(PacketBuffer& packet);
 
-    void setSend(std::string s);
-    void setReceive(std::string r);
+    bool sendMessage(PacketType type, const std::string& payload, Channel channel);
+    bool receiveMessages();
+    void updateReliability();
+    bool pollMessage(NetMessage& message);
+
+    void setSend(PacketType type, const std::string& payload = "");
+    void setReceive(BufferPool::Handle packet);
     void setRun(bool rn);
 
-    ThQueue *getSend();
-    ThQueue *getReceive();
+    ThQueue<BufferPool::Handle> *getSend();
+    ThQueue<BufferPool::Handle> *getReceive();
     bool getRun();
     bool getDebug();
+    BufferPool& getPool();
 
 private:
     std::string _ip;
@@ -47,7 +57,13 @@ private:
     struct sockaddr_in _serverAddr;
     std::mutex _socketMutex;
 
-    ThQueue *_recive;
-    ThQueue *_send;
+    ThQueue<BufferPool::Handle> *_recive;
+    ThQueue<BufferPool::Handle> *_send;
+
+    BufferPool _pool;
+    std::uint16_t _sequence;
+
+    ReliableEndpoint _endpoint;
+    std::mutex _endpointMutex;
 };
 
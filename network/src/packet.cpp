@@ -0,0 +1,239 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** packet
+*/
+
+#include "../includes/packet.hpp"
+
+#include <cstring>
+
+void encodeHeader(const PacketHeader &header, std::uint8_t *dst)
+{
+    dst[0] = static_cast<std::uint8_t>((header.flags << 4) | (header.version & 0x0F));
+    dst[1] = static_cast<std::uint8_t>(header.type);
+    writeU16(dst + 2, header.sequence);
+    writeU16(dst + 4, header.ack);
+    writeU32(dst + 6, header.ackBits);
+    writeU16(dst + 10, header.payloadSize);
+}
+
+bool decodeHeader(const std::uint8_t *src, std::size_t size, PacketHeader &header)
+{
+    if (src == nullptr || size < HEADER_SIZE) {
+        return false;
+    }
+    header.version = src[0] & 0x0F;
+    header.flags = src[0] >> 4;
+    if (header.version != PROTOCOL_VERSION) {
+        return false;
+    }
+    if (src[1] >= static_cast<std::uint8_t>(PacketType::Count)) {
+        return false;
+    }
+    header.type = static_cast<PacketType>(src[1]);
+    header.sequence = readU16(src + 2);
+    header.ack = readU16(src + 4);
+    header.ackBits = readU32(src + 6);
+    header.payloadSize = readU16(src + 10);
+    return header.payloadSize <= MAX_PAYLOAD_SIZE && header.payloadSize <= size - HEADER_SIZE;
+}
+
+// ---------------------------------------------------------------- BufferPool
+
+void BufferPool::Releaser::operator()(PacketBuffer *buffer) const
+{
+    if (pool != nullptr && buffer != nullptr) {
+        pool->release(buffer);
+    }
+}
+
+BufferPool::BufferPool(std::size_t capacity)
+{
+    _storage.reserve(capacity);
+    _free.reserve(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        _storage.push_back(std::make_unique<PacketBuffer>());
+        _free.push_back(_storage.back().get());
+    }
+}
+
+BufferPool::Handle BufferPool::acquire()
+{
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    if (_free.empty()) {
+        return Handle(nullptr, Releaser{this});
+    }
+    PacketBuffer *buffer = _free.back();
+    _free.pop_back();
+    buffer->size = 0;
+    return Handle(buffer, Releaser{this});
+}
+
+std::size_t BufferPool::available()
+{
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    return _free.size();
+}
+
+void BufferPool::release(PacketBuffer *buffer)
+{
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    _free.push_back(buffer);
+}
+
+// -------------------------------------------------------------- PacketWriter
+
+PacketWriter::PacketWriter(PacketBuffer &buffer, const PacketHeader &header)
+    : _buffer(buffer), _header(header), _offset(HEADER_SIZE), _overflow(false)
+{
+}
+
+bool PacketWriter::writeU8(std::uint8_t value)
+{
+    return writeBytes(&value, 1);
+}
+
+bool PacketWriter::writeU16(std::uint16_t value)
+{
+    if (_overflow || _offset + 2 > MAX_PACKET_SIZE) {
+        _overflow = true;
+        return false;
+    }
+    ::writeU16(_buffer.data.data() + _offset, value);
+    _offset += 2;
+    return true;
+}
+
+bool PacketWriter::writeU32(std::uint32_t value)
+{
+    if (_overflow || _offset + 4 > MAX_PACKET_SIZE) {
+        _overflow = true;
+        return false;
+    }
+    ::writeU32(_buffer.data.data() + _offset, value);
+    _offset += 4;
+    return true;
+}
+
+bool PacketWriter::writeF32(float value)
+{
+    std::uint32_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "float must be 32 bits");
+    std::memcpy(&bits, &value, sizeof(bits));
+    return writeU32(bits);
+}
+
+bool PacketWriter::writeBytes(const void *data, std::size_t size)
+{
+    if (_overflow || _offset + size > MAX_PACKET_SIZE) {
+        _overflow = true;
+        return false;
+    }
+    if (size > 0) {
+        std::memcpy(_buffer.data.data() + _offset, data, size);
+    }
+    _offset += size;
+    return true;
+}
+
+std::size_t PacketWriter::finish()
+{
+    _header.payloadSize = static_cast<std::uint16_t>(_offset - HEADER_SIZE);
+    encodeHeader(_header, _buffer.data.data());
+    _buffer.size = _offset;
+    return _buffer.size;
+}
+
+bool PacketWriter::overflow() const
+{
+    return _overflow;
+}
+
+// -------------------------------------------------------------- PacketReader
+
+PacketReader::PacketReader(const std::uint8_t *data, std::size_t size)
+    : _payload(nullptr), _offset(0), _valid(false)
+{
+    if (decodeHeader(data, size, _header)) {
+        _payload = data + HEADER_SIZE;
+        _valid = true;
+    }
+}
+
+bool PacketReader::valid() const
+{
+    return _valid;
+}
+
+const PacketHeader &PacketReader::header() const
+{
+    return _header;
+}
+
+const std::uint8_t *PacketReader::payload() const
+{
+    return _payload;
+}
+
+std::size_t PacketReader::remaining() const
+{
+    return _valid ? _header.payloadSize - _offset : 0;
+}
+
+bool PacketReader::readU8(std::uint8_t &value)
+{
+    return readBytes(&value, 1);
+}
+
+bool PacketReader::readU16(std::uint16_t &value)
+{
+    if (remaining() < 2) {
+        return false;
+    }
+    value = ::readU16(_payload + _offset);
+    _offset += 2;
+    return true;
+}
+
+bool PacketReader::readU32(std::uint32_t &value)
+{
+    if (remaining() < 4) {
+        return false;
+    }
+    value = ::readU32(_payload + _offset);
+    _offset += 4;
+    return true;
+}
+
+bool PacketReader::readF32(float &value)
+{
+    std::uint32_t bits;
+    if (!readU32(bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool PacketReader::readBytes(void *dst, std::size_t size)
+{
+    if (remaining() < size) {
+        return false;
+    }
+    if (size > 0) {
+        std::memcpy(dst, _payload + _offset, size);
+    }
+    _offset += size;
+    return true;
+}
+
+bool PacketReader::skip(std::size_t size)
+{
+    if (remaining() < size) {
+        return false;
+    }
+    _offset += size;
+    return true;
+}
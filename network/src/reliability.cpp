@@ -0,0 +1,345 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** reliability
+*/
+
+#include "../includes/reliability.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+constexpr std::chrono::milliseconds INITIAL_RTO(200);
+constexpr std::chrono::milliseconds MIN_RTO(30);
+constexpr std::chrono::milliseconds MAX_RTO(2000);
+constexpr std::size_t MESSAGE_ID_SIZE = 2;
+
+}
+
+ReliableEndpoint::ReliableEndpoint(SendFunction send)
+    : _send(std::move(send)), _pool(8), _localSequence(0), _sent(),
+      _remoteSequence(0), _remoteBits(0), _hasRemote(false), _ackPending(false),
+      _nextMessageId(0), _nextExpectedId(0),
+      _hasRtt(false), _srtt(0), _rttVar(0), _rto(INITIAL_RTO), _retransmits(0)
+{
+}
+
+bool ReliableEndpoint::send(PacketType type, const std::uint8_t *data, std::size_t size,
+    Channel channel, Clock::time_point now)
+{
+    if (channel == Channel::Unreliable) {
+        return transmit(type, 0, nullptr, 0, data, size, now, 0);
+    }
+    if (size + MESSAGE_ID_SIZE > MAX_PAYLOAD_SIZE) {
+        std::cerr << "Message fiable trop grand (" << size << " octets)." << std::endl;
+        return false;
+    }
+
+    PendingMessage message;
+    message.id = _nextMessageId++;
+    message.type = type;
+    message.payload.assign(data, data + size);
+    message.lastSent = now;
+
+    std::uint8_t prefix[MESSAGE_ID_SIZE];
+    writeU16(prefix, message.id);
+    bool sent = transmit(type, PACKET_FLAG_RELIABLE, prefix, MESSAGE_ID_SIZE, data, size, now, message.id);
+    _pending.push_back(std::move(message));
+    return sent;
+}
+
+bool ReliableEndpoint::transmit(PacketType type, std::uint8_t flags, const std::uint8_t *prefix,
+    std::size_t prefixSize, const std::uint8_t *data, std::size_t size,
+    Clock::time_point now, std::uint16_t messageId, bool retransmission)
+{
+    BufferPool::Handle packet = _pool.acquire();
+    if (!packet) {
+        return false;
+    }
+
+    PacketHeader header;
+    header.type = type;
+    header.flags = flags | (_hasRemote ? PACKET_FLAG_HAS_ACK : 0);
+    header.sequence = _localSequence;
+    header.ack = _remoteSequence;
+    header.ackBits = _remoteBits;
+
+    PacketWriter writer(*packet, header);
+    writer.writeBytes(prefix, prefixSize);
+    writer.writeBytes(data, size);
+    if (writer.overflow()) {
+        return false;
+    }
+    writer.finish();
+
+    SentPacket &entry = _sent[_localSequence % SENT_BUFFER_SIZE];
+    entry.sequence = _localSequence;
+    entry.sentAt = now;
+    entry.messageId = messageId;
+    entry.reliable = (flags & PACKET_FLAG_RELIABLE) != 0;
+    entry.retransmission = retransmission;
+    entry.valid = true;
+
+    ++_localSequence;
+    _ackPending = false;
+    _send(*packet);
+    return true;
+}
+
+bool ReliableEndpoint::receive(const std::uint8_t *data, std::size_t size, Clock::time_point now)
+{
+    PacketReader reader(data, size);
+    if (!reader.valid()) {
+        return false;
+    }
+    const PacketHeader &header = reader.header();
+
+    if (!markReceived(header.sequence)) {
+        return false;
+    }
+    if (header.flags & PACKET_FLAG_HAS_ACK) {
+        processAcks(header.ack, header.ackBits, now);
+    }
+
+    if (header.type == PacketType::Ack) {
+        return true;
+    }
+    if (header.flags & PACKET_FLAG_RELIABLE) {
+        _ackPending = true;
+        std::uint16_t id;
+        if (!reader.readU16(id)) {
+            return false;
+        }
+        deliverReliable(id, header.type, reader.payload() + MESSAGE_ID_SIZE, reader.remaining());
+        return true;
+    }
+
+    NetMessage message;
+    message.type = header.type;
+    message.channel = Channel::Unreliable;
+    message.payload.assign(reader.payload(), reader.payload() + header.payloadSize);
+    _inbox.push_back(std::move(message));
+    return true;
+}
+
+bool ReliableEndpoint::markReceived(std::uint16_t sequence)
+{
+    if (!_hasRemote) {
+        _hasRemote = true;
+        _remoteSequence = sequence;
+        _remoteBits = 0;
+        return true;
+    }
+    if (sequenceGreater(sequence, _remoteSequence)) {
+        std::uint16_t shift = static_cast<std::uint16_t>(sequence - _remoteSequence);
+        _remoteBits = shift > 32 ? 0 : ((_remoteBits << 1) | 1u) << (shift - 1);
+        _remoteSequence = sequence;
+        return true;
+    }
+    std::uint16_t age = static_cast<std::uint16_t>(_remoteSequence - sequence);
+    if (age == 0 || age > 32) {
+        return false;
+    }
+    std::uint32_t bit = 1u << (age - 1);
+    if (_remoteBits & bit) {
+        return false;
+    }
+    _remoteBits |= bit;
+    return true;
+}
+
+void ReliableEndpoint::processAcks(std::uint16_t ack, std::uint32_t ackBits, Clock::time_point now)
+{
+    onPacketAcked(ack, now);
+    for (std::uint16_t i = 0; i < 32; ++i) {
+        if (ackBits & (1u << i)) {
+            onPacketAcked(static_cast<std::uint16_t>(ack - 1 - i), now);
+        }
+    }
+}
+
+void ReliableEndpoint::onPacketAcked(std::uint16_t sequence, Clock::time_point now)
+{
+    SentPacket &entry = _sent[sequence % SENT_BUFFER_SIZE];
+    if (!entry.valid || entry.sequence != sequence) {
+        return;
+    }
+    entry.valid = false;
+    // Un échantillon pris sur une retransmission annulerait le recul du
+    // RTO alors que le lien est encore mauvais (algorithme de Karn).
+    if (!entry.retransmission) {
+        updateRtt(now - entry.sentAt);
+    }
+
+    if (entry.reliable) {
+        std::uint16_t id = entry.messageId;
+        auto it = std::find_if(_pending.begin(), _pending.end(),
+            [id](const PendingMessage &message) { return message.id == id; });
+        if (it != _pending.end()) {
+            _pending.erase(it);
+        }
+    }
+}
+
+void ReliableEndpoint::updateRtt(Clock::duration sample)
+{
+    if (!_hasRtt) {
+        _srtt = sample;
+        _rttVar = sample / 2;
+        _hasRtt = true;
+    } else {
+        Clock::duration error = _srtt > sample ? _srtt - sample : sample - _srtt;
+        _rttVar = (_rttVar * 3 + error) / 4;
+        _srtt = (_srtt * 7 + sample) / 8;
+    }
+    _rto = std::clamp<Clock::duration>(_srtt + _rttVar * 4, MIN_RTO, MAX_RTO);
+}
+
+void ReliableEndpoint::deliverReliable(std::uint16_t id, PacketType type,
+    const std::uint8_t *data, std::size_t size)
+{
+    if (id != _nextExpectedId) {
+        if (sequenceGreater(id, _nextExpectedId) && _outOfOrder.find(id) == _outOfOrder.end()) {
+            NetMessage message;
+            message.type = type;
+            message.channel = Channel::ReliableOrdered;
+            message.payload.assign(data, data + size);
+            _outOfOrder.emplace(id, std::move(message));
+        }
+        return;
+    }
+
+    NetMessage message;
+    message.type = type;
+    message.channel = Channel::ReliableOrdered;
+    message.payload.assign(data, data + size);
+    _inbox.push_back(std::move(message));
+    ++_nextExpectedId;
+
+    for (auto it = _outOfOrder.find(_nextExpectedId); it != _outOfOrder.end();
+         it = _outOfOrder.find(_nextExpectedId)) {
+        _inbox.push_back(std::move(it->second));
+        _outOfOrder.erase(it);
+        ++_nextExpectedId;
+    }
+}
+
+void ReliableEndpoint::update(Clock::time_point now)
+{
+    bool expired = false;
+    for (PendingMessage &message : _pending) {
+        if (now - message.lastSent < _rto) {
+            continue;
+        }
+        std::uint8_t prefix[MESSAGE_ID_SIZE];
+        writeU16(prefix, message.id);
+        if (transmit(message.type, PACKET_FLAG_RELIABLE, prefix, MESSAGE_ID_SIZE,
+                message.payload.data(), message.payload.size(), now, message.id, true)) {
+            message.lastSent = now;
+            ++_retransmits;
+            expired = true;
+        }
+    }
+    // RFC 6298 §5.5 : une expiration double le RTO (une fois par passage,
+    // quel que soit le nombre de messages retransmis), borné à MAX_RTO.
+    if (expired) {
+        _rto = std::min<Clock::duration>(_rto * 2, MAX_RTO);
+    }
+    if (_ackPending) {
+        transmit(PacketType::Ack, 0, nullptr, 0, nullptr, 0, now, 0);
+    }
+}
+
+bool ReliableEndpoint::poll(NetMessage &message)
+{
+    if (_inbox.empty()) {
+        return false;
+    }
+    message = std::move(_inbox.front());
+    _inbox.pop_front();
+    return true;
+}
+
+ReliableEndpoint::Clock::duration ReliableEndpoint::getRtt() const
+{
+    return _srtt;
+}
+
+ReliableEndpoint::Clock::duration ReliableEndpoint::getRto() const
+{
+    return _rto;
+}
+
+std::size_t ReliableEndpoint::getPendingReliable() const
+{
+    return _pending.size();
+}
+
+std::uint64_t ReliableEndpoint::getRetransmitCount() const
+{
+    return _retransmits;
+}
+
+// ----------------------------------------------------------------- LossyLink
+
+LossyLink::LossyLink(float lossRate, Clock::duration delay, Clock::duration jitter, std::uint32_t seed)
+    : _lossRate(lossRate), _delay(delay), _jitter(jitter), _state(seed ? seed : 1),
+      _destination(nullptr), _now(Clock::now()), _dropped(0)
+{
+}
+
+ReliableEndpoint::SendFunction LossyLink::input()
+{
+    return [this](const PacketBuffer &packet) {
+        if ((nextRandom() % 10000) < static_cast<std::uint32_t>(_lossRate * 10000.f)) {
+            ++_dropped;
+            return;
+        }
+        Clock::duration extra(0);
+        if (_jitter.count() > 0) {
+            extra = Clock::duration(nextRandom() % static_cast<std::uint32_t>(_jitter.count()));
+        }
+        InFlight datagram;
+        datagram.deliverAt = _now + _delay + extra;
+        datagram.data.assign(packet.data.begin(), packet.data.begin() + packet.size);
+        _inFlight.push_back(std::move(datagram));
+    };
+}
+
+void LossyLink::setOutput(ReliableEndpoint *destination)
+{
+    _destination = destination;
+}
+
+void LossyLink::update(Clock::time_point now)
+{
+    _now = now;
+    auto due = std::stable_partition(_inFlight.begin(), _inFlight.end(),
+        [now](const InFlight &datagram) { return datagram.deliverAt > now; });
+    std::vector<InFlight> ready(std::make_move_iterator(due), std::make_move_iterator(_inFlight.end()));
+    _inFlight.erase(due, _inFlight.end());
+
+    std::sort(ready.begin(), ready.end(),
+        [](const InFlight &a, const InFlight &b) { return a.deliverAt < b.deliverAt; });
+    for (const InFlight &datagram : ready) {
+        if (_destination != nullptr) {
+            _destination->receive(datagram.data.data(), datagram.data.size(), now);
+        }
+    }
+}
+
+std::uint64_t LossyLink::getDropped() const
+{
+    return _dropped;
+}
+
+std::uint32_t LossyLink::nextRandom()
+{
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+    return _state;
+}
@@ -6,7 +6,6 @@
 */
 
 #include "../includes/udpClient.hpp"
-#include "../includes/threadQueue.hpp"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -17,17 +16,19 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 
 UdpClient::UdpClient(const std::string& ip, int port, bool debug)
-    : _ip(ip), _port(port), _socket(-1), _initialized(false), _debug(debug)
+    : _ip(ip), _port(port), _debug(debug), _socket(-1), _initialized(false),
+      _sequence(0), _endpoint([this](const PacketBuffer& packet) { sendPacket(packet); })
 {
     std::memset(&_serverAddr, 0, sizeof(_serverAddr));
     _serverAddr.sin_family = AF_INET;
     _serverAddr.sin_port = htons(_port);
 
-    _recive = new ThQueue();
-    _send = new ThQueue();
+    _recive = new ThQueue<BufferPool::Handle>();
+    _send = new ThQueue<BufferPool::Handle>();
 }
 
 UdpClient::~UdpClient()
@@ -84,15 +85,50 @@ bool UdpClient::sendData(const std::string& data)
 }
 
 
-std::string UdpClient::receiveData(int bufferSize)
+BufferPool::Handle UdpClient::receiveData()
+{
+    BufferPool::Handle packet = _pool.acquire();
+
+    if (!packet || !receivePacket(*packet)) {
+        return BufferPool::Handle(nullptr, BufferPool::Releaser{&_pool});
+    }
+    return packet;
+}
+
+
+bool UdpClient::sendPacket(const PacketBuffer& packet)
+{
+    std::lock_guard<std::mutex> lock(_socketMutex);
+
+    if (!_initialized) {
+        std::cerr << "Le socket n'a pas été initialisé." << std::endl;
+        return false;
+    }
+
+    ssize_t bytes_sent = sendto(_socket, packet.data.data(), packet.size, 0,
+                                reinterpret_cast<sockaddr*>(&_serverAddr), sizeof(_serverAddr));
+
+    if (bytes_sent < 0) {
+        std::cerr << "Erreur lors de l'envoi de données UDP." << std::endl;
+        return false;
+    }
+    if (_debug) {
+        std::cout << "envoyé : paquet " << static_cast<int>(packet.data[1])
+                  << " (" << bytes_sent << " octets)" << std::endl;
+    }
+    return true;
+}
+
+
+bool UdpClient::receivePacket(PacketBuffer& packet)
 {
     std::lock_guard<std::mutex> lock(_socketMutex);
 
     if (!_initialized) {
         std::cerr << "Le socket n'a pas été initialisé." << std::endl;
-        return "";
+        return false;
     }
-    
+
     fd_set readfds;
     FD_ZERO(&readfds);
     FD_SET(_socket, &readfds);
@@ -102,47 +138,59 @@ std::string UdpClient::receiveData(int bufferSize)
     int activity = select(_socket + 1, &readfds, nullptr, nullptr, &timeout);
 
     if (activity <= 0) {
-        return "";
+        return false;
     }
 
-    char* buffer = new char[bufferSize + 1];
-    std::memset(buffer, 0, bufferSize + 1);
-
     sockaddr_in sender_addr;
     socklen_t addr_len = sizeof(sender_addr);
 
-    ssize_t bytes_received = recvfrom(_socket, buffer, bufferSize, 0, 
+    ssize_t bytes_received = recvfrom(_socket, packet.data.data(), packet.data.size(), 0,
                                       reinterpret_cast<sockaddr*>(&sender_addr), &addr_len);
 
     if (bytes_received <= 0) {
-
-        delete[] buffer;
-        return "";
+        packet.size = 0;
+        return false;
     }
-
-    std::string data(buffer, bytes_received);
-    delete[] buffer;
+    packet.size = static_cast<std::size_t>(bytes_received);
 
     if (_debug) {
-        std::cout << "reçu :" << data << std::endl;
+        std::cout << "reçu : paquet " << static_cast<int>(packet.data[1])
+                  << " (" << bytes_received << " octets)" << std::endl;
     }
+    return true;
+}
 
-    return data;
+bool UdpClient::sendMessage(PacketType type, const std::string& payload, Channel channel)
+{
+    std::lock_guard<std::mutex> lock(_endpointMutex);
+    return _endpoint.send(type, reinterpret_cast<const std::uint8_t*>(payload.data()),
+        payload.size(), channel);
 }
 
-std::string UdpClient::waiter(std::string expect, std::string to_send, int i)
+
+bool UdpClient::receiveMessages()
 {
-    std::string tmp = "NA";
+    BufferPool::Handle packet = _pool.acquire();
 
-    for (; i < 5; ++i) {
-        getReceive()->try_pop(tmp);
-        if (tmp.rfind(expect, 0) == 0) {
-            return tmp;
-        }
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-        setSend(to_send);
+    if (!packet || !receivePacket(*packet)) {
+        return false;
     }
-    return tmp;
+    std::lock_guard<std::mutex> lock(_endpointMutex);
+    return _endpoint.receive(packet->data.data(), packet->size);
+}
+
+
+void UdpClient::updateReliability()
+{
+    std::lock_guard<std::mutex> lock(_endpointMutex);
+    _endpoint.update();
+}
+
+
+bool UdpClient::pollMessage(NetMessage& message)
+{
+    std::lock_guard<std::mutex> lock(_endpointMutex);
+    return _endpoint.poll(message);
 }
 
 
@@ -156,31 +204,44 @@ void UdpClient::disconnect()
     }
 }
 
-void UdpClient::setSend(std::string s)
+void UdpClient::setSend(PacketType type, const std::string& payload)
 {
-    if (s.size() < 2 || s.substr(s.size() - 2) != "\r\n") {
-        s += "\r\n";
+    BufferPool::Handle packet = _pool.acquire();
+    if (!packet) {
+        std::cerr << "Plus de buffer disponible pour l'envoi." << std::endl;
+        return;
     }
+
     std::lock_guard<std::mutex> lock(_socketMutex);
-    _send->push(s);
+    PacketHeader header;
+    header.type = type;
+    header.sequence = _sequence++;
+
+    PacketWriter writer(*packet, header);
+    if (!writer.writeBytes(payload.data(), payload.size())) {
+        std::cerr << "Payload trop grand (" << payload.size() << " octets)." << std::endl;
+        return;
+    }
+    writer.finish();
+    _send->push(std::move(packet));
 }
 
-void UdpClient::setReceive(std::string r)
+void UdpClient::setReceive(BufferPool::Handle packet)
 {
-    if (r.empty())
+    if (!packet || packet->size == 0)
         return;
 
     std::lock_guard<std::mutex> lock(_socketMutex);
-    _recive->push(r);
+    _recive->push(std::move(packet));
 }
 
-ThQueue * UdpClient::getSend()
+ThQueue<BufferPool::Handle> * UdpClient::getSend()
 {
     std::lock_guard<std::mutex> lock(_socketMutex);
     return _send;
 }
 
-ThQueue * UdpClient::getReceive()
+ThQueue<BufferPool::Handle> * UdpClient::getReceive()
 {
     std::lock_guard<std::mutex> lock(_socketMutex);
     return _recive;
@@ -191,4 +252,9 @@ bool UdpClient::getDebug()
 {
     std::lock_guard<std::mutex> lock(_socketMutex);
     return _debug;
-}
\ No newline at end of file
+}
+
+BufferPool& UdpClient::getPool()
+{
+    return _pool;
+}
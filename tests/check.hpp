@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+
+// Vérifications sans framework : un échec est affiché avec son fichier et
+// sa ligne, le test continue, et testResult() donne le code de sortie lu
+// par ctest.
+inline int gCheckFailures = 0;
+
+#define CHECK(expr)                                                                        \
+    do {                                                                                   \
+        if (!(expr)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) a échoué\n", __FILE__, __LINE__, #expr); \
+            ++gCheckFailures;                                                              \
+        }                                                                                  \
+    } while (0)
+
+inline int testResult(const char *name)
+{
+    if (gCheckFailures > 0) {
+        std::fprintf(stderr, "%s : %d vérification(s) en échec\n", name, gCheckFailures);
+        return 1;
+    }
+    std::printf("%s : OK\n", name);
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "check.hpp"
+#include "utils.hpp"
+
+using namespace ecs;
+
+namespace {
+
+constexpr float DT = 1.f / 20.f; // tick serveur lent : le pire cas pour le tunnelling
+
+std::size_t DrainHits()
+{
+    auto& queue = gCoordinator.Events<DamageEvent>();
+    queue.Swap();
+    return queue.Events().size();
+}
+
+// Un canon tire vers la droite à 2400 px/s (120 px par tick, plus que la
+// cible n'est large) sur une cible immobile. Retourne les dégâts reçus.
+int FireAtTarget(const Collider& shape, bool continuous, bool ballistic, int& fired)
+{
+    SystemRefs systems = InitECS();
+    systems.collisionSystem->SetContinuous(continuous);
+    systems.spawnerSystem->SetBallisticProjectiles(ballistic);
+
+    Entity target = gCoordinator.CreateEntity();
+    gCoordinator.AddComponent(target, Transform{400.f, 300.f, 0.f});
+    gCoordinator.AddComponent(target, shape);
+    gCoordinator.AddComponent(target, Team{1});
+    gCoordinator.AddComponent(target, Damager{0});
+    gCoordinator.AddComponent(target, Health{1000, 1000});
+
+    Entity gun = gCoordinator.CreateEntity();
+    gCoordinator.AddComponent(gun, Transform{100.f, 303.f, 0.f});
+    gCoordinator.AddComponent(gun, Team{0});
+    Spawner spawner;
+    spawner.spawnCooldown = 0.6f;
+    spawner.spawnVelocityX = 2400.f;
+    spawner.spawnVelocityY = 0.f;
+    gCoordinator.AddComponent(gun, spawner);
+
+    for (int tick = 0; tick < 200; ++tick) {
+        StepECS(systems, DT);
+    }
+    fired = gCoordinator.GetComponent<Spawner>(gun).spawnCount;
+    return 1000 - gCoordinator.GetComponent<Health>(target).current;
+}
+
+// Chaque tir (Damager par défaut) touche la cible, en intégration
+// explicite comme balistique ; aux seules positions de fin de tick, aucun
+// ne la touche.
+void FastBulletHits(const Collider& shape)
+{
+    for (bool ballistic : {false, true}) {
+        int fired = 0;
+        int damage = FireAtTarget(shape, true, ballistic, fired);
+        CHECK(fired > 10);
+        CHECK(damage == fired * Damager{}.damage);
+        CHECK(FireAtTarget(shape, false, ballistic, fired) == 0);
+    }
+}
+
+void FastBulletHitsCircle()
+{
+    Collider circle;
+    circle.radius = 20.f;
+    FastBulletHits(circle);
+}
+
+void FastBulletHitsBox()
+{
+    Collider box;
+    box.shape = Collider::Shape::Box;
+    box.width = 30.f;
+    box.height = 30.f;
+    FastBulletHits(box);
+}
+
+// Distance du centre relatif (dx, dy) à la somme de Minkowski des deux
+// formes, négative à l'intérieur.
+float MinkowskiDistance(float dx, float dy, const Collider& a, const Collider& b)
+{
+    auto half = [](const Collider& c, bool width) {
+        if (c.shape == Collider::Shape::Circle) {
+            return 0.f;
+        }
+        return (width ? c.width : c.height) / 2.f;
+    };
+    auto radius = [](const Collider& c) { return c.shape == Collider::Shape::Circle ? c.radius : 0.f; };
+    float ox = std::fabs(dx) - (half(a, true) + half(b, true));
+    float oy = std::fabs(dy) - (half(a, false) + half(b, false));
+    float outside = std::hypot(std::max(ox, 0.f), std::max(oy, 0.f));
+    return outside + std::min(std::max(ox, oy), 0.f) - (radius(a) + radius(b));
+}
+
+// Paires aléatoires (cercles et boîtes, les deux en mouvement) : un coup
+// en continu si et seulement si l'une des positions d'un sous-échantillonnage
+// fin du tick se recouvre en discret. Les trajectoires qui frôlent le bord
+// (à moins d'un pixel, plus qu'un sous-pas) sont écartées :
+// l'échantillonnage ne les tranche pas.
+void SweptMatchesSubstepping()
+{
+    constexpr int CASES = 400;
+    constexpr int SUBSTEPS = 200;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    auto randomCollider = [&](float minSize, float range) {
+        Collider collider;
+        if (rng() % 2) {
+            collider.shape = Collider::Shape::Box;
+            collider.width = minSize * 2.f + range * (unit(rng) + 1.f);
+            collider.height = minSize * 2.f + range * (unit(rng) + 1.f);
+        } else {
+            collider.radius = minSize + range / 2.f * (unit(rng) + 1.f);
+        }
+        return collider;
+    };
+
+    int hits = 0;
+    int compared = 0;
+    int mismatches = 0;
+    for (int round = 0; round < CASES; ++round) {
+        Collider shipShape = randomCollider(5.f, 20.f);
+        Collider bulletShape = randomCollider(2.f, 8.f);
+        float shipX = 400.f, shipY = 300.f;
+        float shipVx = 200.f * unit(rng), shipVy = 200.f * unit(rng);
+        float bulletX = 400.f + 80.f * unit(rng), bulletY = 300.f + 80.f * unit(rng);
+        float bulletVx = 3000.f * unit(rng), bulletVy = 3000.f * unit(rng);
+
+        float closest = MinkowskiDistance(bulletX - shipX, bulletY - shipY, shipShape, bulletShape);
+        for (int step = 1; step <= 4 * SUBSTEPS; ++step) {
+            float u = static_cast<float>(step) / (4 * SUBSTEPS);
+            closest = std::min(closest, MinkowskiDistance(bulletX + (bulletVx - shipVx) * DT * u - shipX,
+                bulletY + (bulletVy - shipVy) * DT * u - shipY, shipShape, bulletShape));
+        }
+        if (std::fabs(closest) < 1.f) {
+            continue;
+        }
+
+        SystemRefs systems = InitECS();
+        Entity ship = gCoordinator.CreateEntity();
+        gCoordinator.AddComponent(ship, Transform{shipX, shipY, 0.f});
+        gCoordinator.AddComponent(ship, Velocity{shipVx, shipVy});
+        gCoordinator.AddComponent(ship, shipShape);
+        gCoordinator.AddComponent(ship, Team{0});
+        gCoordinator.AddComponent(ship, Damager{1});
+        gCoordinator.AddComponent(ship, Health{});
+        Entity bullet = gCoordinator.CreateEntity();
+        gCoordinator.AddComponent(bullet, Transform{bulletX, bulletY, 0.f});
+        gCoordinator.AddComponent(bullet, Velocity{bulletVx, bulletVy});
+        gCoordinator.AddComponent(bullet, bulletShape);
+        gCoordinator.AddComponent(bullet, Team{1});
+        gCoordinator.AddComponent(bullet, Damager{0});
+        auto& shipTransform = gCoordinator.WriteComponent<Transform>(ship);
+        auto& bulletTransform = gCoordinator.WriteComponent<Transform>(bullet);
+        gCoordinator.AdvanceTick();
+
+        // Sous-pas discrets, du début à la fin du tick
+        systems.collisionSystem->SetContinuous(false);
+        bool substepHit = false;
+        for (int step = 0; step <= SUBSTEPS && !substepHit; ++step) {
+            float t = DT * static_cast<float>(step) / SUBSTEPS;
+            shipTransform = Transform{shipX + shipVx * t, shipY + shipVy * t, 0.f};
+            bulletTransform = Transform{bulletX + bulletVx * t, bulletY + bulletVy * t, 0.f};
+            systems.collisionSystem->Update(DT);
+            substepHit = DrainHits() > 0;
+        }
+
+        // Un seul tick balayé, depuis la position de fin
+        shipTransform = Transform{shipX + shipVx * DT, shipY + shipVy * DT, 0.f};
+        bulletTransform = Transform{bulletX + bulletVx * DT, bulletY + bulletVy * DT, 0.f};
+        systems.collisionSystem->SetContinuous(true);
+        systems.collisionSystem->Update(DT);
+        bool sweptHit = DrainHits() > 0;
+
+        ++compared;
+        hits += sweptHit;
+        mismatches += sweptHit != substepHit;
+    }
+    CHECK(compared > CASES * 9 / 10);
+    CHECK(hits > compared / 10);
+    CHECK(mismatches == 0);
+}
+
+} // namespace
+
+int main()
+{
+    FastBulletHitsCircle();
+    FastBulletHitsBox();
+    SweptMatchesSubstepping();
+    return testResult("collision_tests");
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cmath>
+
+#include "check.hpp"
+#include "utils.hpp"
+
+using namespace ecs;
+
+namespace {
+
+Entity CreateTarget(Transform transform, Collider collider, int team)
+{
+    Entity entity = gCoordinator.CreateEntity();
+    gCoordinator.AddComponent(entity, transform);
+    gCoordinator.AddComponent(entity, collider);
+    gCoordinator.AddComponent(entity, Health{});
+    gCoordinator.AddComponent(entity, Team{team});
+    return entity;
+}
+
+// Distance d'un point à une boîte AABB (0 à l'intérieur).
+float DistanceToBox(float x, float y, float centerX, float centerY, float halfWidth, float halfHeight)
+{
+    float dx = std::max(std::fabs(x - centerX) - halfWidth, 0.f);
+    float dy = std::max(std::fabs(y - centerY) - halfHeight, 0.f);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Une boîte est enregistrée comme boîte, pas comme son cercle circonscrit :
+// un tir près d'un coin la manque, comme en collision directe.
+void BoxUsesExactShape()
+{
+    SystemRefs systems = InitECS();
+    Collider box;
+    box.shape = Collider::Shape::Box;
+    box.width = 40.f;
+    box.height = 10.f;
+    Entity target = CreateTarget(Transform{100.f, 100.f, 0.f}, box, 1);
+    systems.lagCompensationSystem->Record(1);
+
+    const float radius = 4.f;
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 123.f, 100.f, radius, 0) == target);
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 100.f, 108.f, radius, 0) == target);
+    // Hors du coin arrondi (distance 4.24) mais dans le cercle circonscrit.
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 123.f, 108.f, radius, 0) == MAX_ENTITIES);
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 122.f, 107.f, radius, 0) == target);
+    // Même team : ignoré.
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 100.f, 100.f, radius, 1) == MAX_ENTITIES);
+
+    // Balayage autour de la boîte : touché si et seulement si le centre du
+    // tir est à moins de `radius` de la boîte (rectangle arrondi exact).
+    int mismatches = 0;
+    for (float y = 80.f; y <= 120.f; y += 0.75f) {
+        for (float x = 70.f; x <= 130.f; x += 0.75f) {
+            float distance = DistanceToBox(x, y, 100.f, 100.f, 20.f, 5.f);
+            if (std::fabs(distance - radius) < 1e-3f) {
+                continue;
+            }
+            bool hit = systems.lagCompensationSystem->RewindQuery(1, x, y, radius, 0) == target;
+            mismatches += hit != (distance < radius);
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Le plus proche l'emporte, et la fenêtre en x tient compte de la plus
+// large boîte de la frame.
+void NearestAndWideBoxes()
+{
+    SystemRefs systems = InitECS();
+    Collider wide;
+    wide.shape = Collider::Shape::Box;
+    wide.width = 400.f;
+    wide.height = 20.f;
+    Entity far = CreateTarget(Transform{300.f, 300.f, 0.f}, wide, 1);
+    Collider circle;
+    circle.radius = 10.f;
+    Entity near = CreateTarget(Transform{480.f, 300.f, 0.f}, circle, 1);
+    systems.lagCompensationSystem->Record(1);
+
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 490.f, 300.f, 2.f, 0) == near);
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 110.f, 305.f, 2.f, 0) == far);
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 110.f, 315.f, 2.f, 0) == MAX_ENTITIES);
+}
+
+// Seules les entités avec Health sont enregistrées : un projectile ennemi
+// plus proche du tir ne masque pas le vaisseau visé.
+void ProjectilesAreNotTargets()
+{
+    SystemRefs systems = InitECS();
+    Collider hull;
+    hull.radius = 12.f;
+    Entity ship = CreateTarget(Transform{200.f, 200.f, 0.f}, hull, 1);
+
+    Entity bullet = gCoordinator.CreateEntity();
+    gCoordinator.AddComponent(bullet, Transform{205.f, 200.f, 0.f});
+    Collider small;
+    small.radius = 3.f;
+    gCoordinator.AddComponent(bullet, small);
+    gCoordinator.AddComponent(bullet, Team{1});
+    gCoordinator.AddComponent(bullet, Damager{});
+    systems.lagCompensationSystem->Record(1);
+
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 206.f, 200.f, 2.f, 0) == ship);
+    CHECK(systems.lagCompensationSystem->RewindQuery(1, 230.f, 200.f, 2.f, 0) == MAX_ENTITIES);
+}
+
+} // namespace
+
+int main()
+{
+    BoxUsesExactShape();
+    NearestAndWideBoxes();
+    ProjectilesAreNotTargets();
+    return testResult("lag_compensation_tests");
+}
@@ -0,0 +1,252 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** packet_tests
+*/
+
+#include "check.hpp"
+#include "packet.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+std::uint32_t nextRandom(std::uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Paquet de test : en-tête complet et `payloadSize` octets numérotés.
+std::vector<std::uint8_t> makePacket(std::uint16_t payloadSize)
+{
+    std::vector<std::uint8_t> packet(HEADER_SIZE + payloadSize);
+    PacketHeader header;
+    header.type = PacketType::Snapshot;
+    header.payloadSize = payloadSize;
+    encodeHeader(header, packet.data());
+    for (std::size_t i = 0; i < payloadSize; ++i) {
+        packet[HEADER_SIZE + i] = static_cast<std::uint8_t>(i);
+    }
+    return packet;
+}
+
+void headerRoundTrip()
+{
+    PacketHeader header;
+    header.flags = PACKET_FLAG_RELIABLE | PACKET_FLAG_HAS_ACK;
+    header.type = PacketType::Input;
+    header.sequence = 0xBEEF;
+    header.ack = 0x1234;
+    header.ackBits = 0xDEADBEEF;
+    header.payloadSize = 0;
+
+    std::uint8_t raw[HEADER_SIZE];
+    encodeHeader(header, raw);
+    CHECK(raw[0] == ((header.flags << 4) | PROTOCOL_VERSION));
+    CHECK(raw[2] == 0xEF && raw[3] == 0xBE); // little-endian
+
+    PacketHeader decoded;
+    CHECK(decodeHeader(raw, sizeof(raw), decoded));
+    CHECK(decoded.version == PROTOCOL_VERSION);
+    CHECK(decoded.flags == header.flags);
+    CHECK(decoded.type == header.type);
+    CHECK(decoded.sequence == header.sequence);
+    CHECK(decoded.ack == header.ack);
+    CHECK(decoded.ackBits == header.ackBits);
+    CHECK(decoded.payloadSize == 0);
+
+    for (std::uint8_t type = 0; type < static_cast<std::uint8_t>(PacketType::Count); ++type) {
+        header.type = static_cast<PacketType>(type);
+        encodeHeader(header, raw);
+        CHECK(decodeHeader(raw, sizeof(raw), decoded) && decoded.type == header.type);
+    }
+}
+
+void payloadRoundTrip()
+{
+    PacketBuffer buffer;
+    PacketHeader header;
+    header.type = PacketType::Snapshot;
+    header.sequence = 7;
+    const char bytes[] = "r-type";
+
+    PacketWriter writer(buffer, header);
+    CHECK(writer.writeU8(0xAB));
+    CHECK(writer.writeU16(0xCDEF));
+    CHECK(writer.writeU32(0x01234567));
+    CHECK(writer.writeF32(-12.5f));
+    CHECK(writer.writeBytes(bytes, sizeof(bytes)));
+    std::size_t size = writer.finish();
+    CHECK(!writer.overflow());
+    CHECK(size == HEADER_SIZE + 1 + 2 + 4 + 4 + sizeof(bytes));
+    CHECK(buffer.size == size);
+
+    PacketReader reader(buffer.data.data(), buffer.size);
+    CHECK(reader.valid());
+    CHECK(reader.header().sequence == 7);
+    CHECK(reader.header().payloadSize == size - HEADER_SIZE);
+    CHECK(reader.payload() == buffer.data.data() + HEADER_SIZE);
+
+    std::uint8_t u8 = 0;
+    std::uint16_t u16 = 0;
+    std::uint32_t u32 = 0;
+    float f32 = 0.f;
+    char text[sizeof(bytes)] = {};
+    CHECK(reader.readU8(u8) && u8 == 0xAB);
+    CHECK(reader.readU16(u16) && u16 == 0xCDEF);
+    CHECK(reader.readU32(u32) && u32 == 0x01234567);
+    CHECK(reader.readF32(f32) && f32 == -12.5f);
+    CHECK(reader.readBytes(text, sizeof(text)) && std::memcmp(text, bytes, sizeof(bytes)) == 0);
+    CHECK(reader.remaining() == 0);
+    CHECK(!reader.readU8(u8));
+}
+
+void truncatedBuffers()
+{
+    std::vector<std::uint8_t> packet = makePacket(32);
+    PacketHeader header;
+
+    CHECK(!decodeHeader(nullptr, packet.size(), header));
+    // En-tête incomplet, puis payload coupé à chaque longueur possible.
+    for (std::size_t size = 0; size < packet.size(); ++size) {
+        CHECK(!decodeHeader(packet.data(), size, header));
+        CHECK(!PacketReader(packet.data(), size).valid());
+    }
+    CHECK(decodeHeader(packet.data(), packet.size(), header));
+
+    // Lecture au-delà du payload annoncé : refusée sans rien consommer.
+    PacketReader reader(packet.data(), packet.size());
+    std::uint8_t rest[64];
+    CHECK(!reader.readBytes(rest, 33));
+    CHECK(!reader.skip(33));
+    CHECK(reader.remaining() == 32);
+    CHECK(reader.skip(30));
+    std::uint32_t u32 = 0;
+    CHECK(!reader.readU32(u32));
+    CHECK(reader.remaining() == 2);
+}
+
+void mismatchedPayloadLength()
+{
+    PacketHeader header;
+
+    // Longueur annoncée plus grande que le datagramme.
+    std::vector<std::uint8_t> packet = makePacket(16);
+    writeU16(packet.data() + 10, 17);
+    CHECK(!decodeHeader(packet.data(), packet.size(), header));
+
+    // Plus courte : seuls les octets annoncés sont lisibles.
+    writeU16(packet.data() + 10, 8);
+    PacketReader shorter(packet.data(), packet.size());
+    CHECK(shorter.valid());
+    CHECK(shorter.remaining() == 8);
+    CHECK(shorter.skip(8) && !shorter.skip(1));
+
+    // Au-delà de MAX_PAYLOAD_SIZE, même si le tampon est assez grand.
+    std::vector<std::uint8_t> big = makePacket(0);
+    big.resize(HEADER_SIZE + 0xFFFF);
+    writeU16(big.data() + 10, static_cast<std::uint16_t>(MAX_PAYLOAD_SIZE + 1));
+    CHECK(!decodeHeader(big.data(), big.size(), header));
+    writeU16(big.data() + 10, static_cast<std::uint16_t>(MAX_PAYLOAD_SIZE));
+    CHECK(decodeHeader(big.data(), big.size(), header));
+
+    // L'écriture s'arrête à MAX_PACKET_SIZE et le signale.
+    PacketBuffer buffer;
+    PacketWriter writer(buffer, PacketHeader{});
+    std::vector<std::uint8_t> payload(MAX_PAYLOAD_SIZE, 0x5A);
+    CHECK(writer.writeBytes(payload.data(), payload.size()));
+    CHECK(!writer.writeU8(1));
+    CHECK(writer.overflow());
+    CHECK(!writer.writeU8(1));
+    CHECK(writer.finish() == MAX_PACKET_SIZE);
+    CHECK(PacketReader(buffer.data.data(), buffer.size).valid());
+}
+
+void wrongVersionOrType()
+{
+    std::vector<std::uint8_t> packet = makePacket(4);
+    PacketHeader header;
+
+    // Le protocole n'a pas de nombre magique : la version (quartet bas de
+    // l'octet 0) et le type en tiennent lieu.
+    for (std::uint8_t version = 0; version < 16; ++version) {
+        packet[0] = static_cast<std::uint8_t>((packet[0] & 0xF0) | version);
+        CHECK(decodeHeader(packet.data(), packet.size(), header) == (version == PROTOCOL_VERSION));
+    }
+    packet[0] = PROTOCOL_VERSION;
+    for (unsigned type = static_cast<unsigned>(PacketType::Count); type < 256; ++type) {
+        packet[1] = static_cast<std::uint8_t>(type);
+        CHECK(!decodeHeader(packet.data(), packet.size(), header));
+        CHECK(!PacketReader(packet.data(), packet.size()).valid());
+    }
+}
+
+// Octets aléatoires, puis paquets valides aux octets retournés : le
+// décodage ne lit jamais hors du tampon (vérifié sous ASan) et ce qu'il
+// accepte est cohérent.
+void garbageInput()
+{
+    std::uint32_t state = 0x1234567;
+    std::vector<std::uint8_t> data;
+    std::size_t accepted = 0;
+
+    for (int round = 0; round < 20000; ++round) {
+        std::size_t size = nextRandom(state) % (MAX_PACKET_SIZE + 1);
+        if (round % 2 == 0) {
+            data.resize(size);
+            for (std::uint8_t &byte : data) {
+                byte = static_cast<std::uint8_t>(nextRandom(state));
+            }
+            if (size > 0) {
+                data[0] = static_cast<std::uint8_t>((data[0] & 0xF0) | PROTOCOL_VERSION);
+            }
+        } else {
+            data = makePacket(static_cast<std::uint16_t>(nextRandom(state) % (MAX_PAYLOAD_SIZE + 1)));
+            for (int flips = 0; flips < 3; ++flips) {
+                data[nextRandom(state) % data.size()] ^= static_cast<std::uint8_t>(1u << (nextRandom(state) % 8));
+            }
+        }
+        // Copie exacte sur le tas : ASan détecte le moindre octet de trop.
+        std::vector<std::uint8_t> exact(data);
+        PacketReader reader(exact.data(), exact.size());
+        if (!reader.valid()) {
+            continue;
+        }
+        ++accepted;
+        const PacketHeader &header = reader.header();
+        CHECK(header.version == PROTOCOL_VERSION);
+        CHECK(header.type < PacketType::Count);
+        CHECK(header.payloadSize <= MAX_PAYLOAD_SIZE);
+        CHECK(HEADER_SIZE + header.payloadSize <= exact.size());
+
+        std::size_t consumed = 0;
+        std::uint32_t value;
+        while (reader.readU32(value)) {
+            consumed += 4;
+        }
+        std::uint8_t byte;
+        while (reader.readU8(byte)) {
+            consumed += 1;
+        }
+        CHECK(consumed == header.payloadSize);
+    }
+    CHECK(accepted > 0);
+}
+
+}
+
+int main()
+{
+    headerRoundTrip();
+    payloadRoundTrip();
+    truncatedBuffers();
+    mismatchedPayloadLength();
+    wrongVersionOrType();
+    garbageInput();
+    return testResult("packet_tests");
+}
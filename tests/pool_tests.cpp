@@ -0,0 +1,97 @@
+#include "check.hpp"
+#include "utils.hpp"
+
+using namespace ecs;
+
+namespace {
+
+constexpr float DT = 1.f / 60.f;
+
+void Run(const SystemRefs& systems, float seconds)
+{
+    for (int tick = 0; tick < static_cast<int>(seconds / DT); ++tick) {
+        StepECS(systems, DT);
+    }
+}
+
+// Un canon qui tire un seul projectile poolé ; retourne le projectile actif.
+Entity FireOnce(const SystemRefs& systems, float speed)
+{
+    Entity gun = gCoordinator.CreateEntity();
+    gCoordinator.AddComponent(gun, Transform{400.f, 300.f, 0.f});
+    gCoordinator.AddComponent(gun, Team{0});
+    Spawner spawner;
+    spawner.maxSpawns = 1;
+    spawner.spawnTimer = spawner.spawnCooldown; // tire au tick suivant
+    spawner.spawnVelocityX = speed;
+    spawner.spawnVelocityY = 0.f;
+    gCoordinator.AddComponent(gun, spawner);
+
+    for (int tick = 0; tick < 4; ++tick) {
+        StepECS(systems, DT);
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            if (gCoordinator.IsPooled(entity) && gCoordinator.IsEntityEnabled(entity)) {
+                return entity;
+            }
+        }
+    }
+    return MAX_ENTITIES;
+}
+
+// Un projectile en pause (SetEntityEnabled) n'est pas parqué : il garde sa
+// durée de vie et, balistique, sa sortie du Boundary. Les deux échéances
+// passent pendant la pause ; il est parqué au premier tick après reprise.
+void PausedProjectileKeepsTimers()
+{
+    // Immobile : seule la Lifetime (3 s) le fait expirer.
+    // Rapide : il sort de l'écran en 0,2 s, bien avant sa Lifetime.
+    for (float speed : {0.f, 2000.f}) {
+        SystemRefs systems = InitECS();
+        Entity projectile = FireOnce(systems, speed);
+        CHECK(projectile != MAX_ENTITIES);
+        gCoordinator.SetEntityEnabled(projectile, false);
+        Run(systems, speed == 0.f ? 4.f : 1.f);
+        CHECK(!gCoordinator.IsParked(projectile));
+        CHECK(systems.spawnerSystem->GetParkedProjectiles() == 0);
+
+        gCoordinator.SetEntityEnabled(projectile, true);
+        Run(systems, 2 * DT);
+        CHECK(gCoordinator.IsParked(projectile));
+        CHECK(!gCoordinator.IsEntityEnabled(projectile));
+        CHECK(systems.spawnerSystem->GetParkedProjectiles() == 1);
+    }
+}
+
+// Détruire un projectile en pause le parque (il reste désactivé) au lieu
+// de le perdre, et il est réutilisé au tir suivant.
+void PausedProjectileDestroyed()
+{
+    SystemRefs systems = InitECS();
+    Entity projectile = FireOnce(systems, 0.f);
+    gCoordinator.SetEntitiesEnabled({projectile}, false);
+    gCoordinator.RequestDestroyEntity(projectile);
+    gCoordinator.ProcessDestructions();
+    CHECK(gCoordinator.IsParked(projectile));
+    CHECK(!gCoordinator.IsEntityEnabled(projectile));
+    CHECK(systems.spawnerSystem->GetParkedProjectiles() == 1);
+
+    // Une seconde demande ne le parque pas deux fois.
+    gCoordinator.RequestDestroyEntity(projectile);
+    gCoordinator.ProcessDestructions();
+    CHECK(systems.spawnerSystem->GetParkedProjectiles() == 1);
+
+    Entity again = FireOnce(systems, 0.f);
+    CHECK(again == projectile);
+    CHECK(!gCoordinator.IsParked(projectile));
+    CHECK(gCoordinator.IsEntityEnabled(projectile));
+    CHECK(systems.spawnerSystem->GetParkedProjectiles() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    PausedProjectileKeepsTimers();
+    PausedProjectileDestroyed();
+    return testResult("pool_tests");
+}
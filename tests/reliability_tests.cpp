@@ -0,0 +1,234 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** reliability_tests
+*/
+
+#include "check.hpp"
+#include "reliability.hpp"
+
+#include <chrono>
+#include <set>
+#include <vector>
+
+namespace {
+
+using Clock = ReliableEndpoint::Clock;
+using std::chrono::milliseconds;
+
+constexpr milliseconds STEP(5);
+
+std::vector<std::uint8_t> encodeIndex(std::uint32_t index)
+{
+    std::vector<std::uint8_t> payload(4);
+    writeU32(payload.data(), index);
+    return payload;
+}
+
+std::uint32_t decodeIndex(const NetMessage &message)
+{
+    return message.payload.size() == 4 ? readU32(message.payload.data()) : 0xFFFFFFFFu;
+}
+
+// Deux endpoints reliés par deux LossyLink (un par sens) : pertes, délai
+// et gigue supérieure au pas, donc paquets réordonnés. A envoie 300
+// messages fiables et un message non fiable par pas ; B doit recevoir les
+// fiables dans l'ordre, chacun une seule fois.
+void orderedExactlyOnceOverLossyLink()
+{
+    LossyLink forward(0.25f, milliseconds(30), milliseconds(40), 7);
+    LossyLink backward(0.25f, milliseconds(30), milliseconds(40), 11);
+    ReliableEndpoint a(forward.input());
+    ReliableEndpoint b(backward.input());
+    forward.setOutput(&b);
+    backward.setOutput(&a);
+
+    constexpr std::uint32_t RELIABLE_COUNT = 300;
+    Clock::time_point now = Clock::now();
+    std::uint32_t sent = 0;
+    std::uint32_t unreliableSent = 0;
+    std::vector<std::uint32_t> reliable;
+    std::set<std::uint32_t> unreliable;
+
+    for (int step = 0; step < 4000 && reliable.size() < RELIABLE_COUNT; ++step) {
+        now += STEP;
+        forward.update(now);
+        backward.update(now);
+
+        if (sent < RELIABLE_COUNT && step % 2 == 0) {
+            std::vector<std::uint8_t> payload = encodeIndex(sent++);
+            CHECK(a.send(PacketType::Message, payload.data(), payload.size(), Channel::ReliableOrdered, now));
+        }
+        std::vector<std::uint8_t> payload = encodeIndex(unreliableSent++);
+        a.send(PacketType::Snapshot, payload.data(), payload.size(), Channel::Unreliable, now);
+        a.update(now);
+        b.update(now);
+
+        NetMessage message;
+        while (b.poll(message)) {
+            if (message.channel == Channel::ReliableOrdered) {
+                CHECK(message.type == PacketType::Message);
+                reliable.push_back(decodeIndex(message));
+            } else {
+                CHECK(message.type == PacketType::Snapshot);
+                CHECK(unreliable.insert(decodeIndex(message)).second);
+            }
+        }
+    }
+
+    CHECK(reliable.size() == RELIABLE_COUNT);
+    for (std::uint32_t i = 0; i < reliable.size(); ++i) {
+        CHECK(reliable[i] == i);
+    }
+    CHECK(forward.getDropped() > 0 && backward.getDropped() > 0);
+    CHECK(a.getRetransmitCount() > 0);
+    // Le non fiable n'est ni rejoué ni complété : environ 25 % perdu.
+    CHECK(unreliable.size() < unreliableSent);
+    CHECK(unreliable.size() > unreliableSent / 2);
+}
+
+// Le premier message fiable est perdu : les non fiables envoyés après lui
+// arrivent tout de suite, et le second fiable attend la retransmission du
+// premier pour être délivré.
+void unreliableNotBlockedByMissingReliable()
+{
+    LossyLink forward(0.f, milliseconds(10), milliseconds(0));
+    LossyLink backward(0.f, milliseconds(10), milliseconds(0));
+    ReliableEndpoint::SendFunction link = forward.input();
+    bool dropNextReliable = true;
+    ReliableEndpoint a([&](const PacketBuffer &packet) {
+        PacketReader reader(packet.data.data(), packet.size);
+        if (dropNextReliable && (reader.header().flags & PACKET_FLAG_RELIABLE)) {
+            dropNextReliable = false;
+            return;
+        }
+        link(packet);
+    });
+    ReliableEndpoint b(backward.input());
+    forward.setOutput(&b);
+    backward.setOutput(&a);
+
+    Clock::time_point now = Clock::now();
+    forward.update(now);
+    backward.update(now);
+    std::vector<std::uint8_t> first = encodeIndex(0);
+    std::vector<std::uint8_t> second = encodeIndex(1);
+    std::vector<std::uint8_t> state = encodeIndex(42);
+    a.send(PacketType::Message, first.data(), first.size(), Channel::ReliableOrdered, now);
+    a.send(PacketType::Snapshot, state.data(), state.size(), Channel::Unreliable, now);
+    a.send(PacketType::Message, second.data(), second.size(), Channel::ReliableOrdered, now);
+    a.send(PacketType::Snapshot, state.data(), state.size(), Channel::Unreliable, now);
+
+    std::vector<NetMessage> received;
+    auto run = [&](milliseconds duration) {
+        for (Clock::time_point end = now + duration; now < end;) {
+            now += STEP;
+            forward.update(now);
+            backward.update(now);
+            a.update(now);
+            b.update(now);
+            NetMessage message;
+            while (b.poll(message)) {
+                received.push_back(message);
+            }
+        }
+    };
+
+    // Avant la retransmission (RTO ramené à 60 ms par l'ack du second
+    // fiable, RTT de 20 ms) : seuls les non fiables sont là.
+    run(milliseconds(40));
+    CHECK(received.size() == 2);
+    for (const NetMessage &message : received) {
+        CHECK(message.channel == Channel::Unreliable);
+    }
+    CHECK(a.getRetransmitCount() == 0);
+
+    run(milliseconds(200));
+    CHECK(a.getRetransmitCount() == 1);
+    CHECK(received.size() == 4);
+    if (received.size() == 4) {
+        CHECK(received[2].channel == Channel::ReliableOrdered && decodeIndex(received[2]) == 0);
+        CHECK(received[3].channel == Channel::ReliableOrdered && decodeIndex(received[3]) == 1);
+    }
+    CHECK(a.getPendingReliable() == 0);
+}
+
+// Lien coupé : le RTO double à chaque expiration jusqu'à MAX_RTO (2 s).
+// L'acquittement d'une retransmission ne le recalcule pas ; un échange
+// jamais retransmis, si.
+void rtoBacksOffAndRecoversOnFreshSample()
+{
+    LossyLink forward(0.f, milliseconds(10), milliseconds(0));
+    LossyLink backward(0.f, milliseconds(10), milliseconds(0));
+    ReliableEndpoint::SendFunction link = forward.input();
+    bool linkUp = false;
+    ReliableEndpoint a([&](const PacketBuffer &packet) {
+        if (linkUp) {
+            link(packet);
+        }
+    });
+    ReliableEndpoint b(backward.input());
+    forward.setOutput(&b);
+    backward.setOutput(&a);
+
+    Clock::time_point now = Clock::now();
+    forward.update(now);
+    backward.update(now);
+    std::vector<std::uint8_t> payload = encodeIndex(5);
+    a.send(PacketType::Message, payload.data(), payload.size(), Channel::ReliableOrdered, now);
+    CHECK(a.getRto() == milliseconds(200));
+
+    const milliseconds expected[] = {
+        milliseconds(400), milliseconds(800), milliseconds(1600), milliseconds(2000), milliseconds(2000)};
+    for (milliseconds rto : expected) {
+        Clock::duration before = a.getRto();
+        a.update(now + before - STEP);
+        CHECK(a.getRto() == before);
+        now += before;
+        a.update(now);
+        CHECK(a.getRto() == rto);
+    }
+    CHECK(a.getRetransmitCount() == 5);
+
+    // Le lien revient : la retransmission suivante est acquittée, sans
+    // toucher au RTO.
+    linkUp = true;
+    now += a.getRto();
+    a.update(now);
+    for (int step = 0; step < 20; ++step) {
+        now += STEP;
+        forward.update(now);
+        backward.update(now);
+        b.update(now);
+    }
+    CHECK(a.getPendingReliable() == 0);
+    CHECK(a.getRto() == milliseconds(2000));
+
+    // Un aller-retour neuf : RTO recalculé depuis le RTT mesuré (30 ms,
+    // la réponse de B partant 10 ms après réception).
+    a.send(PacketType::Input, payload.data(), payload.size(), Channel::Unreliable, now);
+    for (int step = 0; step < 4; ++step) {
+        now += STEP;
+        forward.update(now);
+        backward.update(now);
+    }
+    b.send(PacketType::Snapshot, payload.data(), payload.size(), Channel::Unreliable, now);
+    for (int step = 0; step < 4; ++step) {
+        now += STEP;
+        forward.update(now);
+        backward.update(now);
+    }
+    CHECK(a.getRtt() > milliseconds(0));
+    CHECK(a.getRto() < milliseconds(2000));
+}
+
+}
+
+int main()
+{
+    orderedExactlyOnceOverLossyLink();
+    unreliableNotBlockedByMissingReliable();
+    rtoBacksOffAndRecoversOnFreshSample();
+    return testResult("reliability_tests");
+}
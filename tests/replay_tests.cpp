@@ -0,0 +1,318 @@
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "check.hpp"
+#include "replay.hpp"
+#include "utils.hpp"
+
+using namespace ecs;
+
+namespace {
+
+constexpr float DT = 1.f / 60.f;
+constexpr const char* REPLAY_PATH = "replay_tests.rtrp";
+
+// Partie type : des joueurs qui tirent en se déplaçant, des spawners d'IA
+// ennemis qui tirent aussi, avec le pattern `enemyPattern` et le
+// comportement `enemyBehavior`.
+void BuildMatch(int players, int spawners, std::uint8_t enemyPattern = 0, std::uint8_t enemyBehavior = 0)
+{
+    for (int i = 0; i < players; ++i) {
+        Entity player = gCoordinator.CreateEntity();
+        gCoordinator.AddComponent(player, Transform{100.f, 100.f + 120.f * static_cast<float>(i), 0.f});
+        gCoordinator.AddComponent(player, Velocity{});
+        gCoordinator.AddComponent(player, PlayerInput{});
+        Collider collider;
+        collider.radius = 16.f;
+        gCoordinator.AddComponent(player, collider);
+        gCoordinator.AddComponent(player, Health{100, 100});
+        gCoordinator.AddComponent(player, Team{0});
+        Boundary boundary;
+        boundary.destroy = false;
+        gCoordinator.AddComponent(player, boundary);
+        Spawner gun;
+        gun.spawnCooldown = 0.2f + 0.05f * static_cast<float>(i);
+        gun.spawnVelocityX = 600.f;
+        gun.spawnVelocityY = 0.f;
+        gCoordinator.AddComponent(player, gun);
+    }
+    for (int i = 0; i < spawners; ++i) {
+        Entity enemy = gCoordinator.CreateEntity();
+        float x = 500.f + static_cast<float>((i * 37) % 280);
+        float y = 20.f + static_cast<float>((i * 53) % 560);
+        gCoordinator.AddComponent(enemy, Transform{x, y, 0.f});
+        gCoordinator.AddComponent(enemy, Velocity{});
+        Collider collider;
+        collider.radius = 14.f;
+        gCoordinator.AddComponent(enemy, collider);
+        gCoordinator.AddComponent(enemy, Health{40, 40});
+        gCoordinator.AddComponent(enemy, Team{1});
+        gCoordinator.AddComponent(enemy, Damager{15});
+        AIController ai;
+        ai.decisionTimer = 0.1f * static_cast<float>(i % 5);
+        ai.behavior = enemyBehavior;
+        gCoordinator.AddComponent(enemy, ai);
+        Boundary boundary;
+        boundary.wrap = true;
+        gCoordinator.AddComponent(enemy, boundary);
+        Spawner gun;
+        gun.spawnCooldown = 0.4f + 0.1f * static_cast<float>(i % 4);
+        gun.spawnTimer = 0.05f * static_cast<float>(i % 7);
+        gun.spawnVelocityX = -300.f;
+        gun.spawnVelocityY = 40.f * static_cast<float>(i % 3) - 40.f;
+        gun.pattern = enemyPattern;
+        gCoordinator.AddComponent(enemy, gun);
+    }
+}
+
+// Entrées d'un tick : chaque joueur change de direction par moments, et
+// une vague d'ennemis arrive de l'extérieur de temps en temps.
+void PlayTick(const SystemRefs& systems, ReplayRecorder* recorder, std::uint32_t tick)
+{
+    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+        if (!gCoordinator.HasComponent<PlayerInput>(entity)) {
+            continue;
+        }
+        PlayerInput input;
+        input.direction = static_cast<int>(1 + (tick / 7 + entity * 3) % 9);
+        input.firePressed = (tick / 11 + entity) % 2 == 0;
+        gCoordinator.WriteComponent<PlayerInput>(entity) = input;
+        if (recorder) {
+            recorder->RecordInput(entity, input);
+        }
+    }
+    if (tick % 40 == 13) {
+        float y = static_cast<float>((tick * 7) % 560) + 20.f;
+        systems.spawnerSystem->SpawnExternal(Spawner::SpawnType::Enemy, 780.f, y);
+        if (recorder) {
+            recorder->RecordSpawn(static_cast<std::uint8_t>(Spawner::SpawnType::Enemy), 780.f, y, 0);
+        }
+    }
+    StepECS(systems, DT);
+    if (recorder) {
+        recorder->EndTick();
+    }
+}
+
+std::vector<std::uint8_t> SaveBytes()
+{
+    std::vector<std::uint8_t> bytes;
+    CHECK(gCoordinator.SaveWorld(bytes));
+    return bytes;
+}
+
+// Rejoue REPLAY_PATH dans un monde neuf ; retourne le nombre de ticks.
+std::uint32_t Replay()
+{
+    SystemRefs systems = InitECS();
+    ReplayPlayer player;
+    CHECK(player.Open(REPLAY_PATH));
+    ApplyReplaySettings(systems, player.GetSettings());
+    ReplayHooks hooks;
+    hooks.spawn = [&systems](const ReplayEvent& event) {
+        auto type = static_cast<Spawner::SpawnType>(event.spawnKind);
+        return systems.spawnerSystem->SpawnExternal(type, event.x, event.y) != MAX_ENTITIES;
+    };
+    std::vector<ReplayEvent> events;
+    std::uint32_t ticks = 0;
+    while (player.NextTick(events)) {
+        for (const ReplayEvent& event : events) {
+            CHECK(ApplyReplayEvent(event, hooks));
+        }
+        StepECS(systems, DT);
+        ++ticks;
+    }
+    CHECK(player.GetEndTick() == player.GetTick());
+    return ticks;
+}
+
+// Enregistre `ticks` ticks de la partie en cours puis la rejoue dans un
+// monde neuf : le monde final doit être identique à l'octet près.
+void CheckReplayMatches(const SystemRefs& systems, std::uint32_t ticks)
+{
+    ReplayRecorder recorder;
+    CHECK(recorder.Open(REPLAY_PATH, DT, gCoordinator.GetTick(), CaptureReplaySettings(systems)));
+    for (std::uint32_t tick = 0; tick < ticks; ++tick) {
+        PlayTick(systems, &recorder, tick);
+    }
+    CHECK(recorder.Close());
+    std::vector<std::uint8_t> recorded = SaveBytes();
+
+    CHECK(Replay() == ticks);
+    std::vector<std::uint8_t> replayed = SaveBytes();
+    CHECK(replayed.size() == recorded.size());
+    CHECK(replayed == recorded);
+}
+
+// Enregistré dès le début de la partie.
+void ReplayMatchesRecording()
+{
+    SystemRefs systems = InitECS();
+    BuildMatch(4, 24);
+    CheckReplayMatches(systems, 300);
+}
+
+// Enregistré en cours de partie : les roues de timers du serveur ont un
+// historique (cascades, échéances replanifiées) que le monde rechargé n'a
+// pas, les échéances doivent tomber dans le même ordre.
+void ReplayAfterWarmUp()
+{
+    for (std::uint32_t warmUp : {50u, 200u}) {
+        SystemRefs systems = InitECS();
+        BuildMatch(4, 24);
+        for (std::uint32_t tick = 0; tick < warmUp; ++tick) {
+            PlayTick(systems, nullptr, tick);
+        }
+        CheckReplayMatches(systems, 300);
+    }
+}
+
+// Patterns et modes de projectiles autres que ceux par défaut : le replay,
+// lancé avec les réglages par défaut, reprend ceux de l'enregistrement.
+void SettingsReplayed()
+{
+    SystemRefs systems = InitECS();
+    BulletPattern fan;
+    fan.name = "fan";
+    fan.count = 5;
+    fan.spread = 0.8f;
+    PatternLibrary patterns;
+    std::uint8_t index = patterns.Add(fan);
+    systems.spawnerSystem->SetPatterns(patterns);
+    systems.spawnerSystem->SetProjectilePooling(false);
+    systems.spawnerSystem->SetBallisticProjectiles(false);
+    BuildMatch(4, 24, index);
+    CheckReplayMatches(systems, 300);
+
+    ReplayPlayer player;
+    CHECK(player.Open(REPLAY_PATH));
+    const ReplaySettings& settings = player.GetSettings();
+    CHECK(!settings.projectilePooling);
+    CHECK(!settings.ballisticProjectiles);
+    CHECK(settings.patterns.Size() == 2);
+    CHECK(settings.patterns.Get(index).name == "fan");
+    CHECK(settings.patterns.Get(index).count == 5);
+    CHECK(settings.patterns.Get(index).spread == 0.8f);
+}
+
+// Table de comportements chargée par le serveur : le replay la reprend.
+void BehaviorsReplayed()
+{
+    SystemRefs systems = InitECS();
+    Behavior kite = DefaultBehavior();
+    kite.name = "kite";
+    kite.decisionCooldown = 0.25f;
+    kite.actions[static_cast<std::size_t>(AIController::State::Patrolling)] = {Motion::Drift, 0.f, -30.f, 45.f};
+    kite.actions[static_cast<std::size_t>(AIController::State::Chasing)] = {Motion::Flee, 120.f, 0.f, -60.f, true};
+    BehaviorLibrary behaviors;
+    std::uint8_t index = behaviors.Add(kite);
+    systems.aiSystem->SetBehaviors(behaviors);
+    BuildMatch(4, 24, 0, index);
+    CheckReplayMatches(systems, 300);
+
+    ReplayPlayer player;
+    CHECK(player.Open(REPLAY_PATH));
+    const BehaviorLibrary& replayed = player.GetSettings().behaviors;
+    CHECK(replayed.Size() == 2);
+    CHECK(replayed.Find("kite") == index);
+    CHECK(replayed.Get(index).decisionCooldown == 0.25f);
+    const StateAction& chasing = replayed.Get(index).actions[static_cast<std::size_t>(AIController::State::Chasing)];
+    CHECK(chasing.motion == Motion::Flee);
+    CHECK(chasing.speed == 120.f);
+    CHECK(chasing.vy == -60.f);
+    CHECK(chasing.driftWithoutTarget);
+}
+
+// Un comportement invalide (mouvement inconnu) fait refuser le journal.
+void CorruptBehaviorRejected()
+{
+    SystemRefs systems = InitECS();
+    BuildMatch(1, 1);
+    CheckReplayMatches(systems, 10);
+
+    std::vector<std::uint8_t> data;
+    if (std::FILE* file = std::fopen(REPLAY_PATH, "rb")) {
+        int byte;
+        while ((byte = std::fgetc(file)) != EOF) {
+            data.push_back(static_cast<std::uint8_t>(byte));
+        }
+        std::fclose(file);
+    }
+    // En-tête (28 octets), drapeaux, nombre de comportements, nom
+    // "default" (longueur + 7 octets), puis le mouvement de l'état Idle.
+    constexpr std::size_t IDLE_MOTION = 28 + 1 + 1 + 1 + 7;
+    CHECK(data.size() > IDLE_MOTION);
+    CHECK(data[IDLE_MOTION] == static_cast<std::uint8_t>(Motion::Stop));
+    data[IDLE_MOTION] = 0xFF;
+    std::FILE* file = std::fopen(REPLAY_PATH, "wb");
+    CHECK(file && std::fwrite(data.data(), 1, data.size(), file) == data.size());
+    if (file) {
+        std::fclose(file);
+    }
+
+    ReplayPlayer player;
+    CHECK(!player.Open(REPLAY_PATH));
+}
+
+// Le journal couvre les ticks clos par EndTick(), qu'il reste ou non des
+// événements en attente à la fermeture.
+void LengthCountsClosedTicks()
+{
+    for (bool pending : {false, true}) {
+        SystemRefs systems = InitECS();
+        BuildMatch(1, 0);
+        ReplayRecorder recorder;
+        CHECK(recorder.Open(REPLAY_PATH, DT, 5, CaptureReplaySettings(systems)));
+        for (std::uint32_t tick = 0; tick < 10; ++tick) {
+            PlayTick(systems, &recorder, tick);
+        }
+        if (pending) {
+            PlayerInput input;
+            input.direction = 2;
+            recorder.RecordInput(0, input);
+            recorder.RecordSpawn(static_cast<std::uint8_t>(Spawner::SpawnType::Enemy), 10.f, 10.f, 0);
+        }
+        CHECK(recorder.Close());
+
+        SystemRefs replaySystems = InitECS();
+        ReplayPlayer player;
+        CHECK(player.Open(REPLAY_PATH));
+        CHECK(player.GetEndTick() == 15);
+        CHECK(Replay() == 10);
+    }
+}
+
+// Une écriture refusée (disque plein) est signalée par Close().
+void WriteFailureReported()
+{
+    std::FILE* probe = std::fopen("/dev/full", "wb");
+    if (!probe) {
+        return;
+    }
+    std::fclose(probe);
+    SystemRefs systems = InitECS();
+    BuildMatch(4, 24);
+    ReplayRecorder recorder;
+    bool opened = recorder.Open("/dev/full", DT, 0, CaptureReplaySettings(systems));
+    if (opened) {
+        PlayTick(systems, &recorder, 0);
+        CHECK(!recorder.Close());
+    }
+    CHECK(!recorder.Open("/nonexistent/replay_tests.rtrp", DT, 0, CaptureReplaySettings(systems)));
+}
+
+} // namespace
+
+int main()
+{
+    ReplayMatchesRecording();
+    ReplayAfterWarmUp();
+    SettingsReplayed();
+    BehaviorsReplayed();
+    CorruptBehaviorRejected();
+    LengthCountsClosedTicks();
+    WriteFailureReported();
+    std::remove(REPLAY_PATH);
+    return testResult("replay_tests");
+}
@@ -0,0 +1,126 @@
+#include <cstdint>
+#include <vector>
+
+#include "check.hpp"
+#include "snapshot.hpp"
+
+using namespace ecs;
+
+namespace {
+
+EntityState MakeState(Entity entity, std::int32_t x)
+{
+    EntityState state;
+    state.entity = entity;
+    state.parts = EntityState::HasHealth;
+    state.x = x;
+    state.y = -x;
+    state.health = 100;
+    return state;
+}
+
+bool SameStates(const Snapshot& a, const Snapshot& b)
+{
+    if (a.tick != b.tick || a.entities.size() != b.entities.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.entities.size(); ++i) {
+        const EntityState& left = a.entities[i];
+        const EntityState& right = b.entities[i];
+        if (left.entity != right.entity || left.parts != right.parts || left.ChangedFields(right) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RoundTrip()
+{
+    Snapshot baseline{10, {MakeState(1, 10), MakeState(2, 20), MakeState(40, 400), MakeState(MAX_ENTITIES - 1, 7)}};
+    Snapshot current{11, {MakeState(2, 21), MakeState(3, 30), MakeState(40, 400), MakeState(MAX_ENTITIES - 1, 8)}};
+
+    std::vector<std::uint8_t> full;
+    WriteSnapshot(current, nullptr, full);
+    Snapshot decoded;
+    CHECK(ReadSnapshot(full.data(), full.size(), nullptr, decoded));
+    CHECK(SameStates(decoded, current));
+
+    std::vector<std::uint8_t> delta;
+    WriteSnapshot(current, &baseline, delta);
+    CHECK(delta.size() < full.size());
+    CHECK(ReadSnapshot(delta.data(), delta.size(), &baseline, decoded));
+    CHECK(SameStates(decoded, current));
+
+    // Base absente ou d'un autre tick.
+    CHECK(!ReadSnapshot(delta.data(), delta.size(), nullptr, decoded));
+    Snapshot other = baseline;
+    other.tick = 9;
+    CHECK(!ReadSnapshot(delta.data(), delta.size(), &other, decoded));
+}
+
+// Ids dans l'ordre donné, tels qu'un pair malveillant pourrait les écrire :
+// WriteSnapshot suit simplement l'ordre de `entities`.
+std::vector<std::uint8_t> Forge(const std::vector<Entity>& ids)
+{
+    Snapshot forged{5, {}};
+    for (Entity id : ids) {
+        forged.entities.push_back(MakeState(id, static_cast<std::int32_t>(id)));
+    }
+    std::vector<std::uint8_t> data;
+    WriteSnapshot(forged, nullptr, data);
+    return data;
+}
+
+void RejectsUnorderedIds()
+{
+    Snapshot decoded;
+    std::vector<std::uint8_t> data = Forge({3, 4, 20});
+    CHECK(ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+    CHECK(decoded.entities.size() == 3);
+
+    data = Forge({3, 3});
+    CHECK(!ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+    data = Forge({7, 2});
+    CHECK(!ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+    data = Forge({0, 1, 2, 1});
+    CHECK(!ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+
+    // Un doublon contre une base aurait dupliqué l'entité à la fusion.
+    Snapshot baseline{4, {MakeState(3, 3), MakeState(8, 8)}};
+    Snapshot current{5, {MakeState(3, 30), MakeState(3, 31), MakeState(8, 8)}};
+    data.clear();
+    WriteSnapshot(current, &baseline, data);
+    CHECK(!ReadSnapshot(data.data(), data.size(), &baseline, decoded));
+}
+
+void RejectsOutOfRangeIds()
+{
+    Snapshot decoded;
+    std::vector<std::uint8_t> data = Forge({MAX_ENTITIES - 1});
+    CHECK(ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+    data = Forge({MAX_ENTITIES});
+    CHECK(!ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+    data = Forge({1, (1u << ENTITY_BITS) - 1});
+    CHECK(!ReadSnapshot(data.data(), data.size(), nullptr, decoded));
+}
+
+void RejectsTruncatedData()
+{
+    Snapshot decoded;
+    std::vector<std::uint8_t> data = Forge({1, 2, 300});
+    for (std::size_t size = 0; size < data.size(); ++size) {
+        std::vector<std::uint8_t> truncated(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(size));
+        CHECK(!ReadSnapshot(truncated.data(), truncated.size(), nullptr, decoded));
+    }
+}
+
+} // namespace
+
+int main()
+{
+    RoundTrip();
+    RejectsUnorderedIds();
+    RejectsOutOfRangeIds();
+    RejectsTruncatedData();
+    return testResult("snapshot_tests");
+}
@@ -0,0 +1,183 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** threading_tests
+*/
+
+#include "check.hpp"
+#include "threadPool.hpp"
+#include "workStealingDeque.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int THIEVES = 4;
+
+// Le propriétaire pousse et retire pendant que des voleurs prennent en
+// haut. Capacité initiale de 4 : la deque grandit plusieurs fois sous les
+// vols. Chaque élément doit être pris une et une seule fois.
+void dequeItemsTakenExactlyOnce()
+{
+    constexpr std::uint32_t ITEMS = 200000;
+    WorkStealingDeque<std::uint32_t> deque(4);
+    std::unique_ptr<std::atomic<int>[]> taken(new std::atomic<int>[ITEMS]);
+    for (std::uint32_t i = 0; i < ITEMS; ++i) {
+        taken[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<std::uint32_t> total{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; ++t) {
+        thieves.emplace_back([&] {
+            std::uint32_t item;
+            while (!done.load(std::memory_order_acquire)) {
+                if (deque.steal(item)) {
+                    taken[item].fetch_add(1, std::memory_order_relaxed);
+                    total.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // Rafales de push (qui font grandir la deque) suivies de quelques pop.
+    std::uint32_t next = 0;
+    std::uint32_t item;
+    while (next < ITEMS) {
+        std::uint32_t burst = 1 + next % 97;
+        for (std::uint32_t i = 0; i < burst && next < ITEMS; ++i) {
+            deque.push(next++);
+        }
+        for (std::uint32_t i = 0; i < burst / 3; ++i) {
+            if (deque.pop(item)) {
+                taken[item].fetch_add(1, std::memory_order_relaxed);
+                total.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        // Laisse les voleurs tourner même sur un seul cœur.
+        if (next % 16 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    while (deque.pop(item)) {
+        taken[item].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Vide : un vol en cours finit avant que son voleur relise `done`.
+    done.store(true, std::memory_order_release);
+    for (std::thread &thief : thieves) {
+        thief.join();
+    }
+
+    CHECK(total.load() == ITEMS);
+    int wrong = 0;
+    for (std::uint32_t i = 0; i < ITEMS; ++i) {
+        wrong += taken[i].load(std::memory_order_relaxed) != 1;
+    }
+    CHECK(wrong == 0);
+    CHECK(deque.size() == 0);
+    CHECK(!deque.steal(item));
+}
+
+// shutdown() rend la main une fois tout joué : tâches injectées déjà en
+// file et sous-tâches qu'elles soumettent depuis les workers. Ensuite,
+// une soumission extérieure est refusée.
+void shutdownDrainsEverything()
+{
+    constexpr int TASKS = 2000;
+    constexpr int CHILDREN = 3;
+    ThreadPoolOptions options;
+    options.threads = THIEVES;
+    ThreadPool pool(options);
+    std::atomic<int> ran{0};
+    std::atomic<int> refused{0};
+
+    for (int i = 0; i < TASKS; ++i) {
+        CHECK(pool.submit([&pool, &ran, &refused] {
+            for (int c = 0; c < CHILDREN; ++c) {
+                // Soumis depuis un worker : accepté même pendant l'arrêt.
+                if (!pool.submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); })) {
+                    refused.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            ran.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+    pool.shutdown();
+    CHECK(refused.load() == 0);
+    CHECK(ran.load() == TASKS * (CHILDREN + 1));
+
+    bool accepted = pool.submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+    CHECK(!accepted);
+    CHECK(ran.load() == TASKS * (CHILDREN + 1));
+    pool.shutdown();
+}
+
+// Des groupes imbriqués : chaque tâche ouvre son propre TaskGroup et
+// l'attend depuis un worker, en aidant plutôt qu'en bloquant. Plus de
+// tâches en attente que de workers : un blocage ferait pendre le test.
+void nestedTaskGroups()
+{
+    constexpr int OUTER = 64;
+    constexpr int INNER = 32;
+    constexpr int LEAVES = 4;
+    ThreadPoolOptions options;
+    options.threads = THIEVES;
+    ThreadPool pool(options);
+    std::atomic<int> leaves{0};
+    std::atomic<int> innerDone{0};
+
+    TaskGroup outer(pool);
+    for (int i = 0; i < OUTER; ++i) {
+        outer.run([&] {
+            TaskGroup inner(pool);
+            for (int j = 0; j < INNER; ++j) {
+                inner.run([&] {
+                    TaskGroup leaf(pool);
+                    for (int k = 0; k < LEAVES; ++k) {
+                        leaf.run([&leaves] { leaves.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                    leaf.wait();
+                    innerDone.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    CHECK(innerDone.load() == OUTER * INNER);
+    CHECK(leaves.load() == OUTER * INNER * LEAVES);
+
+    // parallelFor imbriqué : même mécanisme, chaque indice vu une fois.
+    std::vector<std::atomic<int>> seen(OUTER * INNER);
+    pool.parallelFor(OUTER, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            pool.parallelFor(INNER, 4, [&, i](std::size_t first, std::size_t last) {
+                for (std::size_t j = first; j < last; ++j) {
+                    seen[i * INNER + j].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    });
+    int wrong = 0;
+    for (const std::atomic<int> &count : seen) {
+        wrong += count.load() != 1;
+    }
+    CHECK(wrong == 0);
+}
+
+}
+
+int main()
+{
+    dequeItemsTakenExactlyOnce();
+    shutdownDrainsEverything();
+    nestedTaskGroups();
+    return testResult("threading_tests");
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "workStealingDeque.hpp"
+
+struct ThreadPoolOptions {
+    // 0 : un worker par cœur (std::thread::hardware_concurrency()).
+    std::size_t threads{0};
+    // Fixe le worker i sur le cœur (firstCpu + i) modulo le nombre de
+    // cœurs. Pour un serveur dédié : pas de migration, caches conservés.
+    bool pinThreads{false};
+    std::size_t firstCpu{0};
+};
+
+// Pool de threads à vol de tâches, partagé par tout le processus (ECS,
+// réseau, salles de jeu) pour ne pas lancer plus de threads que de cœurs.
+//
+// Chaque worker a sa deque de Chase-Lev : une tâche soumise depuis un
+// worker y est poussée et reprise en LIFO par lui-même ; les workers
+// inoccupés la volent. Une tâche soumise depuis un autre thread passe par
+// une file d'injection commune. Un worker sans travail dort sur une
+// variable de condition, réveillé seulement si quelqu'un dort.
+//
+// Une tâche ne doit pas lever d'exception.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(const ThreadPoolOptions &options = {});
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Faux après shutdown(), sauf depuis un worker : une tâche en cours
+    // peut encore créer ses sous-tâches, qui seront jouées. Une tâche
+    // refusée est laissée intacte à l'appelant.
+    bool submit(Task &&task);
+
+    // Exécute une tâche en attente, s'il y en a, sur le thread appelant.
+    // Permet d'attendre en aidant (TaskGroup::wait) plutôt qu'en bloquant.
+    bool runOne();
+
+    // Découpe [0, count) en tranches de `grain` et appelle
+    // body(début, fin) sur le pool ; le thread appelant participe et ne
+    // rend la main qu'une fois toutes les tranches faites.
+    void parallelFor(std::size_t count, std::size_t grain,
+        const std::function<void(std::size_t, std::size_t)> &body);
+
+    // Arrêt propre : refuse les nouvelles soumissions extérieures, laisse
+    // les workers vider toutes les files puis les joint. Idempotent ; le
+    // destructeur l'appelle.
+    void shutdown();
+
+    std::size_t getThreadCount() const;
+    // Tâches prises dans la deque d'un autre worker depuis le lancement.
+    std::uint64_t getStealCount() const;
+    // Cœurs auxquels les workers ont effectivement été fixés.
+    std::size_t getPinnedCount() const;
+
+    // Indice du worker courant de ce pool, ou -1 hors du pool. Sert par
+    // exemple d'indice de tampon d'événements ECS (indice + 1, le thread
+    // principal gardant le tampon 0).
+    int currentWorker() const;
+
+private:
+    struct Worker {
+        WorkStealingDeque<Task *> deque;
+        std::thread thread;
+        std::uint64_t seed{};
+        int cpu{-1}; // cœur où se fixer, -1 : pas de fixation
+    };
+
+    void workerLoop(std::size_t index);
+    Task *take(int self, std::uint64_t &seed);
+    void execute(Task *task);
+    void wake();
+    static bool pinCurrentThread(std::size_t cpu);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::mutex _injectionMutex;
+    std::deque<Task *> _injection;
+    std::atomic<std::size_t> _injectionSize{0}; // lu sans verrou avant de le prendre
+
+    // Tâches soumises et pas encore prises, workers endormis : le couple
+    // évite un réveil perdu sans verrou côté soumission (voir wake()).
+    std::atomic<std::size_t> _queued{0};
+    std::atomic<std::size_t> _sleepers{0};
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+
+    std::atomic<bool> _stopping{false};
+    std::atomic<std::uint64_t> _steals{0};
+    std::atomic<std::size_t> _pinned{0};
+    std::atomic<std::size_t> _started{0};
+};
+
+// Tâches attendues ensemble : wait() exécute des tâches du pool tant que
+// celles du groupe ne sont pas toutes finies.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void run(ThreadPool::Task task);
+    void wait();
+
+private:
+    ThreadPool &_pool;
+    std::atomic<std::size_t> _pending{0};
+};
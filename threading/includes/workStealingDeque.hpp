@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Deque de Chase-Lev (version C11 de Lê, Pop, Cohen et Zappa Nardelli,
+// PPoPP 2013). Le propriétaire pousse et retire en bas (LIFO, données
+// chaudes en cache) sans verrou ; les autres threads volent en haut (FIFO,
+// les tâches les plus anciennes, souvent les plus grosses). Seul le vol du
+// dernier élément passe par un compare-exchange.
+//
+// T doit être trivialement copiable (pointeur de tâche en pratique). Les
+// tableaux remplacés par un agrandissement restent alloués jusqu'à la
+// destruction : un voleur peut encore les lire.
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque stores trivially copyable items");
+
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 1024)
+    {
+        std::size_t size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        _arrays.push_back(std::make_unique<Array>(size));
+        _array.store(_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    // Propriétaire uniquement.
+    void push(T item)
+    {
+        std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        std::int64_t top = _top.load(std::memory_order_acquire);
+        Array *array = _array.load(std::memory_order_relaxed);
+        if (bottom - top > static_cast<std::int64_t>(array->mask)) {
+            array = grow(array, top, bottom);
+        }
+        array->put(bottom, item);
+        // Release : un voleur qui lit le nouveau bottom voit l'élément (et
+        // ce que la tâche pointée contient).
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Propriétaire uniquement.
+    bool pop(T &item)
+    {
+        std::int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        Array *array = _array.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = array->get(bottom);
+        if (top == bottom) {
+            // Dernier élément : course avec les voleurs.
+            bool won = _top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // N'importe quel thread. Faux si la deque est vide ou si un autre
+    // thread a pris l'élément le premier.
+    bool steal(T &item)
+    {
+        std::int64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom = _bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        Array *array = _array.load(std::memory_order_acquire);
+        T candidate = array->get(top);
+        if (!_top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        item = candidate;
+        return true;
+    }
+
+    // Approximatif hors du propriétaire.
+    std::size_t size() const
+    {
+        std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        std::int64_t top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+private:
+    struct Array {
+        explicit Array(std::size_t capacity) : mask(capacity - 1), items(capacity) {}
+
+        T get(std::int64_t index) const
+        {
+            return items[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T item)
+        {
+            items[static_cast<std::size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::vector<std::atomic<T>> items;
+    };
+
+    Array *grow(Array *array, std::int64_t top, std::int64_t bottom)
+    {
+        _arrays.push_back(std::make_unique<Array>((array->mask + 1) * 2));
+        Array *bigger = _arrays.back().get();
+        for (std::int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, array->get(i));
+        }
+        _array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    // Sur des lignes de cache distinctes : top est écrit par les voleurs,
+    // bottom par le propriétaire.
+    alignas(64) std::atomic<std::int64_t> _top{0};
+    alignas(64) std::atomic<std::int64_t> _bottom{0};
+    alignas(64) std::atomic<Array *> _array{nullptr};
+    std::vector<std::unique_ptr<Array>> _arrays; // propriétaire uniquement
+};
@@ -0,0 +1,290 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** threadPool
+*/
+
+#include "../includes/threadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Recherches infructueuses avant de s'endormir : un worker qui vient de
+// finir reprend une tâche fraîche sans payer un réveil.
+constexpr int SPINS_BEFORE_SLEEP = 64;
+
+struct CurrentWorker {
+    const ThreadPool *pool{nullptr};
+    int index{-1};
+};
+
+thread_local CurrentWorker tlsWorker;
+thread_local std::uint64_t helperSeed = 0x2545F4914F6CDD1Dull;
+
+// xorshift64 : choix de la première victime d'un vol.
+std::uint64_t nextRandom(std::uint64_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions &options)
+{
+    std::size_t cores = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::size_t count = options.threads > 0 ? options.threads : cores;
+
+    // Toutes les deques existent avant le premier vol.
+    _workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+        _workers.back()->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+        if (options.pinThreads) {
+            _workers.back()->cpu = static_cast<int>((options.firstCpu + i) % cores);
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        _workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+    }
+    // Chaque worker se fixe lui-même avant sa première tâche ; attendre
+    // qu'ils aient tous démarré rend getPinnedCount() exact dès ici.
+    while (_started.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+}
+
+bool ThreadPool::submit(Task &&task)
+{
+    int self = currentWorker();
+    if (self >= 0) {
+        // Compté avant d'être visible : un voleur ne le décompte jamais
+        // avant qu'il ait été compté.
+        _queued.fetch_add(1, std::memory_order_seq_cst);
+        _workers[static_cast<std::size_t>(self)]->deque.push(new Task(std::move(task)));
+    } else {
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        if (_stopping.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        _queued.fetch_add(1, std::memory_order_seq_cst);
+        _injection.push_back(new Task(std::move(task)));
+        _injectionSize.store(_injection.size(), std::memory_order_release);
+    }
+    wake();
+    return true;
+}
+
+bool ThreadPool::runOne()
+{
+    int self = currentWorker();
+    std::uint64_t &seed = self >= 0 ? _workers[static_cast<std::size_t>(self)]->seed : helperSeed;
+    Task *task = take(self, seed);
+    if (!task) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain,
+    const std::function<void(std::size_t, std::size_t)> &body)
+{
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<std::size_t>(1, grain);
+    TaskGroup group(*this);
+    for (std::size_t begin = grain; begin < count; begin += grain) {
+        std::size_t end = std::min(begin + grain, count);
+        group.run([&body, begin, end] { body(begin, end); });
+    }
+    body(0, std::min(grain, count));
+    group.wait();
+}
+
+void ThreadPool::shutdown()
+{
+    assert(currentWorker() < 0 && "A worker cannot shut its own pool down");
+    {
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        _stopping.store(true, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCondition.notify_all();
+    }
+    for (auto &worker : _workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+std::size_t ThreadPool::getThreadCount() const
+{
+    return _workers.size();
+}
+
+std::uint64_t ThreadPool::getStealCount() const
+{
+    return _steals.load(std::memory_order_relaxed);
+}
+
+std::size_t ThreadPool::getPinnedCount() const
+{
+    return _pinned.load(std::memory_order_relaxed);
+}
+
+int ThreadPool::currentWorker() const
+{
+    return tlsWorker.pool == this ? tlsWorker.index : -1;
+}
+
+void ThreadPool::workerLoop(std::size_t index)
+{
+    tlsWorker = {this, static_cast<int>(index)};
+    Worker &self = *_workers[index];
+    // Sur le thread lui-même, avant toute tâche : fixé depuis le
+    // constructeur, il aurait pu en exécuter quelques-unes ailleurs.
+    if (self.cpu >= 0 && pinCurrentThread(static_cast<std::size_t>(self.cpu))) {
+        _pinned.fetch_add(1, std::memory_order_relaxed);
+    }
+    _started.fetch_add(1, std::memory_order_release);
+    int idle = 0;
+
+    for (;;) {
+        if (Task *task = take(static_cast<int>(index), self.seed)) {
+            execute(task);
+            idle = 0;
+            continue;
+        }
+        // Arrêt seulement une fois tout vidé, sous-tâches comprises.
+        if (_stopping.load(std::memory_order_acquire) && _queued.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+        if (++idle < SPINS_BEFORE_SLEEP) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepers.fetch_add(1, std::memory_order_seq_cst);
+        _sleepCondition.wait(lock, [this] {
+            return _queued.load(std::memory_order_seq_cst) > 0 || _stopping.load(std::memory_order_acquire);
+        });
+        _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    tlsWorker = {};
+}
+
+// Sa propre deque d'abord (LIFO), puis la file d'injection, puis les
+// deques des autres workers en partant d'une victime au hasard.
+ThreadPool::Task *ThreadPool::take(int self, std::uint64_t &seed)
+{
+    Task *task = nullptr;
+    if (self >= 0 && _workers[static_cast<std::size_t>(self)]->deque.pop(task)) {
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    if (_injectionSize.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        if (!_injection.empty()) {
+            task = _injection.front();
+            _injection.pop_front();
+            _injectionSize.store(_injection.size(), std::memory_order_release);
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    std::size_t count = _workers.size();
+    std::size_t start = static_cast<std::size_t>(nextRandom(seed) % count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t victim = (start + i) % count;
+        if (static_cast<int>(victim) != self && _workers[victim]->deque.steal(task)) {
+            _steals.fetch_add(1, std::memory_order_relaxed);
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::execute(Task *task)
+{
+    (*task)();
+    delete task;
+}
+
+// Les deux côtés écrivent puis lisent en seq_cst (_queued puis _sleepers
+// ici, l'inverse dans workerLoop) : au moins l'un voit l'écriture de
+// l'autre, donc soit le worker ne s'endort pas, soit il est réveillé.
+void ThreadPool::wake()
+{
+    if (_sleepers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCondition.notify_one();
+    }
+}
+
+bool ThreadPool::pinCurrentThread(std::size_t cpu)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+TaskGroup::TaskGroup(ThreadPool &pool) : _pool(pool)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void TaskGroup::run(ThreadPool::Task task)
+{
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    ThreadPool::Task counted = [this, task = std::move(task)] {
+        task();
+        _pending.fetch_sub(1, std::memory_order_release);
+    };
+    // Pool arrêté : la tâche est jouée ici, wait() reste correct.
+    if (!_pool.submit(std::move(counted))) {
+        counted();
+    }
+}
+
+void TaskGroup::wait()
+{
+    while (_pending.load(std::memory_order_acquire) > 0) {
+        if (!_pool.runOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
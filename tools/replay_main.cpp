@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2025
+** rtype
+** File description:
+** replay_main
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "replay.hpp"
+#include "utils.hpp"
+
+// Rejoue un journal enregistré par ReplayRecorder sans réseau ni rendu,
+// tick par tick, et affiche le temps de simulation par tick.
+// Usage : r-type_replay <fichier.rtrp> [--loops N]
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "Usage : " << argv[0] << " <fichier.rtrp> [--loops N]" << std::endl;
+        return 1;
+    }
+    std::string path = argv[1];
+    int loops = 1;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (std::string(argv[i]) == "--loops") {
+            loops = std::max(1, std::atoi(argv[i + 1]));
+        }
+    }
+
+    std::vector<double> tickTimes;
+    std::vector<ecs::ReplayEvent> events;
+    std::size_t inputCount = 0;
+    std::size_t spawnCount = 0;
+    std::size_t seedCount = 0;
+
+    for (int loop = 0; loop < loops; ++loop) {
+        ecs::SystemRefs systems = ecs::InitECS();
+        ecs::ReplayPlayer player;
+        if (!player.Open(path)) {
+            return 1;
+        }
+        // Comportements, patterns et modes de projectiles de la partie enregistrée
+        ecs::ApplyReplaySettings(systems, player.GetSettings());
+        // Spawns externes : mêmes fabriques que les Spawners. La simulation
+        // n'a pas de générateur aléatoire : une graine fait échouer le replay.
+        ecs::ReplayHooks hooks;
+        hooks.spawn = [&systems](const ecs::ReplayEvent& event) {
+            auto type = static_cast<ecs::Spawner::SpawnType>(event.spawnKind);
+            return systems.spawnerSystem->SpawnExternal(type, event.x, event.y) != ecs::MAX_ENTITIES;
+        };
+        float dt = player.GetTickDt();
+        while (player.NextTick(events)) {
+            for (const ecs::ReplayEvent& event : events) {
+                if (!ecs::ApplyReplayEvent(event, hooks)) {
+                    std::cerr << "Replay interrompu au tick " << player.GetTick() << "." << std::endl;
+                    return 1;
+                }
+                switch (event.type) {
+                    case ecs::ReplayEvent::Type::Input:
+                        ++inputCount;
+                        break;
+                    case ecs::ReplayEvent::Type::Spawn:
+                        ++spawnCount;
+                        break;
+                    case ecs::ReplayEvent::Type::Seed:
+                        ++seedCount;
+                        break;
+                }
+            }
+            auto start = std::chrono::steady_clock::now();
+            ecs::StepECS(systems, dt);
+            auto end = std::chrono::steady_clock::now();
+            tickTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+    }
+
+    if (tickTimes.empty()) {
+        std::cout << "Aucun tick dans " << path << std::endl;
+        return 0;
+    }
+    std::vector<double> sorted = tickTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double t : sorted) {
+        total += t;
+    }
+    std::cout << "ticks    : " << tickTimes.size() << " (" << loops << " passe(s))\n"
+              << "events   : " << inputCount << " inputs, " << spawnCount << " spawns, "
+              << seedCount << " seeds\n"
+              << "moyenne  : " << total / sorted.size() << " us\n"
+              << "p50      : " << sorted[sorted.size() / 2] << " us\n"
+              << "p99      : " << sorted[sorted.size() * 99 / 100] << " us\n"
+              << "max      : " << sorted.back() << " us" << std::endl;
+    return 0;
+}